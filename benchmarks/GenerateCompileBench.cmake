@@ -0,0 +1,87 @@
+# Helpers to generate the sources of the compile-time benchmarks
+
+# Writes a translation unit operating on an aggregate with num_members members of mixed types
+function(blobify_generate_wide_bench output num_members)
+    set(types uint8_t uint16_t uint32_t uint64_t)
+    set(members "")
+    set(props "")
+    math(EXPR last "${num_members} - 1")
+    foreach(idx RANGE ${last})
+        math(EXPR type_idx "${idx} % 4")
+        list(GET types ${type_idx} type)
+        string(APPEND members "    std::${type} m${idx};\n")
+        math(EXPR big_endian "${idx} % 3")
+        if(big_endian EQUAL 0)
+            string(APPEND props "    props.member<&Wide::m${idx}>().endianness = blob::endian::big;\n")
+        endif()
+    endforeach()
+
+    file(WRITE ${output}.tmp
+"// Generated by GenerateCompileBench.cmake
+#include <blobify/blobify.hpp>
+#include <blobify/memory_storage.hpp>
+
+#include <cstdint>
+
+struct Wide {
+${members}};
+
+constexpr auto properties(blob::tag<Wide>) {
+    blob::properties_t<Wide> props { };
+${props}    return props;
+}
+
+static_assert(blob::detail::total_serialized_size<Wide>() > 0);
+
+Wide load_wide(blob::memory_storage& storage) {
+    return blob::load<Wide>(storage);
+}
+
+void store_wide(blob::memory_storage& storage, const Wide& data) {
+    blob::store(storage, data);
+}
+
+auto lens_load_wide(blob::memory_storage& storage) {
+    return blob::lens_load<&Wide::m${last}>(storage);
+}
+")
+    # Only touch the output if it changed to avoid needless rebuilds
+    configure_file(${output}.tmp ${output} COPYONLY)
+endfunction()
+
+# Writes a translation unit operating on an aggregate nested depth levels deep
+function(blobify_generate_deep_bench output depth)
+    set(levels "struct Level0 {\n    std::uint32_t a;\n    std::uint16_t b;\n};\n")
+    set(chain "")
+    foreach(level RANGE 1 ${depth})
+        math(EXPR prev "${level} - 1")
+        string(APPEND levels "\nstruct Level${level} {\n    std::uint32_t a;\n    Level${prev} inner;\n    std::uint16_t b;\n};\n")
+        string(PREPEND chain "&Level${level}::inner, ")
+    endforeach()
+
+    file(WRITE ${output}.tmp
+"// Generated by GenerateCompileBench.cmake
+#include <blobify/blobify.hpp>
+#include <blobify/memory_storage.hpp>
+
+#include <cstdint>
+
+${levels}
+using Deep = Level${depth};
+
+static_assert(blob::detail::total_serialized_size<Deep>() > 0);
+
+Deep load_deep(blob::memory_storage& storage) {
+    return blob::load<Deep>(storage);
+}
+
+void store_deep(blob::memory_storage& storage, const Deep& data) {
+    blob::store(storage, data);
+}
+
+auto lens_load_deep(blob::memory_storage& storage) {
+    return blob::lens_load<${chain}&Level0::b>(storage);
+}
+")
+    configure_file(${output}.tmp ${output} COPYONLY)
+endfunction()
@@ -0,0 +1,714 @@
+// Runtime throughput benchmarks for load/store operations.
+//
+// Usage: blobify-bench [--records N] [--repetitions N] [--format csv|json] [--read-latency-us N] [--threads N]
+//
+// Each benchmark is run for the given number of repetitions and the fastest
+// run is reported. Results are printed as CSV (default) or as one JSON object
+// per line, so that they can be diffed between revisions.
+//
+// --read-latency-us delays each read from the stream-based backends to emulate
+// slow files, such as files on network filesystems. The unbuffered stream
+// backend is skipped in that case.
+//
+// --threads sets the number of threads used by the parallel benchmarks on
+// contiguous storages. It defaults to the number of hardware threads.
+
+#include <blobify/blobify.hpp>
+#include <blobify/hashing_storage.hpp>
+#include <blobify/memory_storage.hpp>
+#include <blobify/parallel.hpp>
+#include <blobify/readahead_storage.hpp>
+#include <blobify/stream_storage.hpp>
+#include <blobify/validate.hpp>
+#include <blobify/vector_storage.hpp>
+#if !defined(_WIN32)
+#include <blobify/fd_storage.hpp>
+#include <blobify/mmap_storage.hpp>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+namespace Shapes {
+
+// Few small members with padding in between
+struct Narrow {
+    uint32_t id;
+    uint16_t flags;
+    uint8_t kind;
+};
+
+// Many members of mixed size and endianness
+struct Wide {
+    uint32_t m0;  uint16_t m1;  uint8_t m2;  uint64_t m3;
+    uint32_t m4;  uint16_t m5;  uint8_t m6;  uint64_t m7;
+    uint32_t m8;  uint16_t m9;  uint8_t m10; uint64_t m11;
+    uint32_t m12; uint16_t m13; uint8_t m14; uint64_t m15;
+    uint32_t m16; uint16_t m17; uint8_t m18; uint64_t m19;
+    uint32_t m20; uint16_t m21; uint8_t m22; uint64_t m23;
+};
+
+constexpr auto properties(blob::tag<Wide>) {
+    blob::properties_t<Wide> props { };
+    props.member<&Wide::m0>().endianness = blob::endian::big;
+    props.member<&Wide::m5>().endianness = blob::endian::big;
+    props.member<&Wide::m11>().endianness = blob::endian::big;
+    props.member<&Wide::m20>().endianness = blob::endian::big;
+    return props;
+}
+
+// Aggregates containing aggregates
+struct Point {
+    int32_t x;
+    int32_t y;
+};
+
+struct Segment {
+    Point from;
+    Point to;
+};
+
+struct Nested {
+    uint16_t layer;
+    Segment segment;
+    Point anchor;
+    uint32_t color;
+};
+
+// Large std::array members
+struct ArrayHeavy {
+    uint32_t id;
+    std::array<uint16_t, 64> samples;
+    std::array<uint8_t, 32> label;
+};
+
+constexpr auto properties(blob::tag<ArrayHeavy>) {
+    blob::properties_t<ArrayHeavy> props { };
+    props.member<&ArrayHeavy::samples>().endianness = blob::endian::big;
+    return props;
+}
+
+// Members with expected values and enum validation
+enum class Kind : uint8_t { Header = 1, Data = 2, Footer = 3 };
+enum class Codec : uint16_t { Raw = 0, Lz4 = 7, Zstd = 19, Deflate = 100 };
+
+struct ValidationHeavy {
+    uint32_t magic;
+    Kind kind;
+    Codec codec;
+    uint16_t version;
+    std::array<Kind, 8> tags;
+    uint32_t length;
+};
+
+constexpr auto properties(blob::tag<ValidationHeavy>) {
+    blob::properties_t<ValidationHeavy> props { };
+    props.member<&ValidationHeavy::magic>().expected_value = uint32_t { 0x424c4f42 };
+    props.member<&ValidationHeavy::kind>().validate_enum = true;
+    props.member<&ValidationHeavy::codec>().validate_enum = true;
+    props.member<&ValidationHeavy::version>().expected_value = uint16_t { 3 };
+    props.member<&ValidationHeavy::tags>().validate_enum_bounds = true;
+    return props;
+}
+
+// Floating-point members, partly in non-native endianness
+struct Vertex {
+    std::array<float, 3> position;
+    std::array<float, 3> normal;
+    std::array<float, 2> uv;
+    double weight;
+};
+
+constexpr auto properties(blob::tag<Vertex>) {
+    blob::properties_t<Vertex> props { };
+    props.member<&Vertex::normal>().endianness = blob::endian::big;
+    props.member<&Vertex::weight>().endianness = blob::endian::big;
+    return props;
+}
+
+} // namespace Shapes
+
+namespace {
+
+using namespace Shapes;
+
+template<typename T>
+struct shape_traits;
+
+template<>
+struct shape_traits<Narrow> {
+    static constexpr const char* name = "narrow";
+    static constexpr auto lens_member = &Narrow::flags;
+
+    static Narrow make(std::size_t i) {
+        return { static_cast<uint32_t>(i), static_cast<uint16_t>(i * 3), static_cast<uint8_t>(i) };
+    }
+};
+
+template<>
+struct shape_traits<Wide> {
+    static constexpr const char* name = "wide";
+    static constexpr auto lens_member = &Wide::m20;
+
+    static Wide make(std::size_t i) {
+        Wide ret { };
+        ret.m0 = static_cast<uint32_t>(i);
+        ret.m20 = static_cast<uint32_t>(i * 7);
+        ret.m23 = i;
+        return ret;
+    }
+};
+
+template<>
+struct shape_traits<Nested> {
+    static constexpr const char* name = "nested";
+    static constexpr auto lens_member = &Nested::color;
+
+    static Nested make(std::size_t i) {
+        auto coord = static_cast<int32_t>(i);
+        return { static_cast<uint16_t>(i), { { coord, -coord }, { -coord, coord } }, { coord, coord }, static_cast<uint32_t>(i) };
+    }
+};
+
+template<>
+struct shape_traits<ArrayHeavy> {
+    static constexpr const char* name = "array_heavy";
+    static constexpr auto lens_member = &ArrayHeavy::id;
+
+    static ArrayHeavy make(std::size_t i) {
+        ArrayHeavy ret { };
+        ret.id = static_cast<uint32_t>(i);
+        for (std::size_t j = 0; j < ret.samples.size(); ++j) {
+            ret.samples[j] = static_cast<uint16_t>(i + j);
+        }
+        return ret;
+    }
+};
+
+template<>
+struct shape_traits<ValidationHeavy> {
+    static constexpr const char* name = "validation_heavy";
+    static constexpr auto lens_member = &ValidationHeavy::codec;
+
+    static ValidationHeavy make(std::size_t i) {
+        constexpr Codec codecs[] = { Codec::Raw, Codec::Lz4, Codec::Zstd, Codec::Deflate };
+        ValidationHeavy ret { 0x424c4f42, static_cast<Kind>(1 + i % 3), codecs[i % 4], 3, { }, static_cast<uint32_t>(i) };
+        ret.tags.fill(Kind::Data);
+        return ret;
+    }
+};
+
+template<>
+struct shape_traits<Vertex> {
+    static constexpr const char* name = "vertex";
+    static constexpr auto lens_member = &Vertex::weight;
+
+    static Vertex make(std::size_t i) {
+        auto x = static_cast<float>(i);
+        return { { x, x * 0.5f, -x }, { 0.f, 1.f, 0.f }, { x / 1024.f, 0.25f }, static_cast<double>(i) * 0.125 };
+    }
+};
+
+// Prevents the compiler from optimizing away the computation of the given value
+template<typename T>
+void do_not_optimize(const T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * Storage backends under test. Each backend provides a writer() and, if
+ * readable, a reader() positioned at the beginning of the serialized data, and
+ * indicates whether it supports the backward seeks needed by lens operations.
+ */
+struct memory_backend {
+    static constexpr const char* name = "memory";
+    static constexpr bool readable = true;
+    static constexpr bool writable = true;
+    static constexpr bool random_access = true;
+    std::vector<std::byte>& data;
+
+    blob::memory_storage reader() {
+        return { data.data(), data.data(), data.data() + data.size() };
+    }
+
+    blob::memory_storage writer() {
+        return reader();
+    }
+};
+
+struct checked_memory_backend {
+    static constexpr const char* name = "checked_memory";
+    static constexpr bool readable = true;
+    static constexpr bool writable = true;
+    static constexpr bool random_access = true;
+    std::vector<std::byte>& data;
+
+    blob::checked_memory_storage reader() {
+        return { { data.data(), data.data(), data.data() + data.size() } };
+    }
+
+    blob::checked_memory_storage writer() {
+        return reader();
+    }
+};
+
+/// Computes a CRC32C over all accessed data of a memory_storage
+struct hashing_backend {
+    static constexpr const char* name = "crc32c_memory";
+    static constexpr bool readable = true;
+    static constexpr bool writable = true;
+    static constexpr bool random_access = false;
+    std::vector<std::byte>& data;
+    blob::memory_storage base { };
+
+    // Retrieves the digest at the end of each run so that all data is hashed
+    struct storage : blob::hashing_storage<blob::memory_storage> {
+        using hashing_storage::hashing_storage;
+
+        ~storage() {
+            do_not_optimize(digest());
+        }
+    };
+
+    storage reader() {
+        base = { data.data(), data.data(), data.data() + data.size() };
+        return storage { base };
+    }
+
+    storage writer() {
+        return reader();
+    }
+};
+
+/// Stores into a fresh owning buffer on each run, including the cost of growing it
+struct vector_backend {
+    static constexpr const char* name = "vector";
+    static constexpr bool readable = false;
+    static constexpr bool writable = true;
+    static constexpr bool random_access = false;
+
+    blob::vector_storage writer() {
+        return blob::vector_storage { };
+    }
+};
+
+/// In-memory stream buffer that delays each read by a fixed latency
+struct latency_stringbuf : std::stringbuf {
+    std::chrono::microseconds read_latency;
+
+    latency_stringbuf(std::chrono::microseconds read_latency) : read_latency(read_latency) {
+    }
+
+protected:
+    std::streamsize xsgetn(char* target, std::streamsize num_bytes) override {
+        if (read_latency.count()) {
+            std::this_thread::sleep_for(read_latency);
+        }
+        return std::stringbuf::xsgetn(target, num_bytes);
+    }
+};
+
+struct stream_backend {
+    static constexpr const char* name = "stream";
+    static constexpr bool readable = true;
+    static constexpr bool writable = true;
+    static constexpr bool random_access = false;
+    std::vector<std::byte>& data;
+    latency_stringbuf buffer;
+    std::iostream stream { &buffer };
+
+    stream_backend(std::vector<std::byte>& data, std::chrono::microseconds read_latency)
+        : data(data), buffer(read_latency) {
+        buffer.str(std::string(reinterpret_cast<const char*>(data.data()), data.size()));
+    }
+
+    blob::istream_storage reader() {
+        stream.clear();
+        stream.seekg(0);
+        return { { stream } };
+    }
+
+    blob::ostream_storage writer() {
+        stream.clear();
+        stream.seekp(0);
+        return { { stream } };
+    }
+};
+
+struct buffered_stream_backend : stream_backend {
+    static constexpr const char* name = "buffered_stream";
+
+    using stream_backend::stream_backend;
+
+    blob::buffered_istream_storage reader() {
+        stream_backend::reader();
+        return blob::buffered_istream_storage { stream };
+    }
+
+    blob::buffered_ostream_storage writer() {
+        stream_backend::writer();
+        return blob::buffered_ostream_storage { stream };
+    }
+};
+
+/// Reads the stream on a background thread. Stores are covered by buffered_stream_backend
+struct readahead_stream_backend : stream_backend {
+    static constexpr const char* name = "readahead_stream";
+    static constexpr bool writable = false;
+    blob::istream_storage source { { stream } };
+
+    using stream_backend::stream_backend;
+
+    blob::readahead_storage<blob::istream_storage> reader() {
+        stream_backend::reader();
+        return blob::readahead_storage<blob::istream_storage> { source };
+    }
+};
+
+struct type_erased_backend {
+    static constexpr const char* name = "type_erased_memory";
+    static constexpr bool readable = true;
+    static constexpr bool writable = true;
+    static constexpr bool random_access = true;
+    std::vector<std::byte>& data;
+    blob::runtime_storage_adapter<blob::memory_storage> adapter { { } };
+
+    blob::type_erased_storage reader() {
+        adapter.get() = { data.data(), data.data(), data.data() + data.size() };
+        return blob::type_erased_storage { adapter };
+    }
+
+    blob::type_erased_storage writer() {
+        return reader();
+    }
+};
+
+#if !defined(_WIN32)
+struct mmap_backend {
+    static constexpr const char* name = "mmap";
+    static constexpr bool readable = true;
+    static constexpr bool writable = true;
+    static constexpr bool random_access = true;
+    std::string path;
+    blob::mmap_storage storage;
+
+    static std::string make_temporary_file() {
+        char path[] = "/tmp/blobify-bench-XXXXXX";
+        auto fd = ::mkstemp(path);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to create temporary file");
+        }
+        ::close(fd);
+        return path;
+    }
+
+    mmap_backend(std::vector<std::byte>& data)
+        : path(make_temporary_file()), storage(path.c_str(), blob::mmap_storage::mode::read_write) {
+        storage.resize(data.size());
+        std::copy(data.begin(), data.end(), storage.data());
+    }
+
+    ~mmap_backend() {
+        ::unlink(path.c_str());
+    }
+
+    blob::mmap_storage& reader() {
+        storage.seek(-static_cast<std::ptrdiff_t>(storage.position()));
+        return storage;
+    }
+
+    blob::mmap_storage& writer() {
+        return reader();
+    }
+};
+
+/// Writes to a temporary file through writev
+struct fd_backend {
+    static constexpr const char* name = "fd";
+    static constexpr bool readable = false;
+    static constexpr bool writable = true;
+    static constexpr bool random_access = false;
+    int fd;
+
+    fd_backend() {
+        char path[] = "/tmp/blobify-bench-XXXXXX";
+        fd = ::mkstemp(path);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to create temporary file");
+        }
+        ::unlink(path);
+    }
+
+    ~fd_backend() {
+        ::close(fd);
+    }
+
+    blob::fd_ostream_storage writer() {
+        ::lseek(fd, 0, SEEK_SET);
+        return blob::fd_ostream_storage { fd };
+    }
+};
+#endif
+
+struct options {
+    std::size_t num_records = 1'000'000;
+    std::size_t repetitions = 5;
+    bool json = false;
+    std::chrono::microseconds read_latency { 0 };
+    std::size_t num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+};
+
+void print_header(const options& opts) {
+    if (!opts.json) {
+        std::cout << "benchmark,shape,storage,records,record_bytes,ns_per_record,gb_per_s\n";
+    }
+}
+
+void print_result(const options& opts, const char* benchmark, const char* shape, const char* storage,
+                  std::size_t record_bytes, double seconds) {
+    auto ns_per_record = seconds * 1e9 / static_cast<double>(opts.num_records);
+    auto gb_per_s = static_cast<double>(record_bytes * opts.num_records) / seconds / 1e9;
+
+    char line[256];
+    if (opts.json) {
+        std::snprintf(line, sizeof(line),
+                      "{\"benchmark\":\"%s\",\"shape\":\"%s\",\"storage\":\"%s\",\"records\":%zu,\"record_bytes\":%zu,"
+                      "\"ns_per_record\":%.3f,\"gb_per_s\":%.4f}\n",
+                      benchmark, shape, storage, opts.num_records, record_bytes, ns_per_record, gb_per_s);
+    } else {
+        std::snprintf(line, sizeof(line), "%s,%s,%s,%zu,%zu,%.3f,%.4f\n",
+                      benchmark, shape, storage, opts.num_records, record_bytes, ns_per_record, gb_per_s);
+    }
+    std::cout << line << std::flush;
+}
+
+/// Runs f the given number of times and returns the duration of the fastest run in seconds
+template<typename F>
+double measure(std::size_t repetitions, F&& f) {
+    auto best = std::numeric_limits<double>::max();
+    for (std::size_t i = 0; i < repetitions; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+    return best;
+}
+
+/// Parallel loads and stores require storages providing direct access to their memory
+template<typename Storage>
+constexpr bool is_contiguous = blob::detail::is_contiguous_storage_v<std::remove_reference_t<Storage>>;
+
+template<typename T, typename Backend>
+void run_backend(const options& opts, const std::vector<T>& records, Backend& backend) {
+    using traits = shape_traits<T>;
+    constexpr auto record_bytes = blob::detail::total_serialized_size<T>();
+    const auto count = records.size();
+
+    auto report = [&](const char* benchmark, double seconds) {
+        print_result(opts, benchmark, traits::name, Backend::name, record_bytes, seconds);
+    };
+
+    if constexpr (Backend::writable) {
+        report("store", measure(opts.repetitions, [&] {
+            decltype(auto) storage = backend.writer();
+            for (auto& record : records) {
+                blob::store(storage, record);
+            }
+        }));
+
+        report("store_many", measure(opts.repetitions, [&] {
+            decltype(auto) storage = backend.writer();
+            blob::store_many(storage, records);
+        }));
+
+        if constexpr (is_contiguous<decltype(backend.writer())>) {
+            report("store_many_parallel", measure(opts.repetitions, [&] {
+                decltype(auto) storage = backend.writer();
+                blob::store_many_parallel(storage, records, opts.num_threads);
+            }));
+        }
+    }
+
+    if constexpr (Backend::readable) {
+        report("load", measure(opts.repetitions, [&] {
+            decltype(auto) storage = backend.reader();
+            for (std::size_t i = 0; i < count; ++i) {
+                auto record = blob::load<T>(storage);
+                do_not_optimize(record);
+            }
+        }));
+
+        report("load_many", measure(opts.repetitions, [&] {
+            decltype(auto) storage = backend.reader();
+            auto loaded = blob::load_many<std::vector<T>>(storage, count);
+            do_not_optimize(loaded.data());
+        }));
+
+        if constexpr (is_contiguous<decltype(backend.reader())>) {
+            report("load_many_parallel", measure(opts.repetitions, [&] {
+                decltype(auto) storage = backend.reader();
+                auto loaded = blob::load_many_parallel<std::vector<T>>(storage, count, opts.num_threads);
+                do_not_optimize(loaded.data());
+            }));
+        }
+
+        // Without any validation properties, there is nothing to measure
+        if constexpr (blob::detail::has_runtime_checks<T, &blob::detail::properties_for<T>>()) {
+            report("validate_many", measure(opts.repetitions, [&] {
+                decltype(auto) storage = backend.reader();
+                auto valid = blob::validate_many<T>(storage, count).has_value();
+                do_not_optimize(valid);
+            }));
+        }
+
+        if constexpr (Backend::random_access) {
+            report("lens_load", measure(opts.repetitions, [&] {
+                decltype(auto) storage = backend.reader();
+                for (std::size_t i = 0; i < count; ++i) {
+                    auto value = blob::lens_load<traits::lens_member>(storage);
+                    do_not_optimize(value);
+                    storage.seek(record_bytes);
+                }
+            }));
+
+            report("lens_modify", measure(opts.repetitions, [&] {
+                decltype(auto) storage = backend.reader();
+                for (std::size_t i = 0; i < count; ++i) {
+                    // Identity transform, so that validated members stay valid across repetitions.
+                    // The value is passed through do_not_optimize to keep the compiler from eliding the store
+                    blob::lens_modify<traits::lens_member>(storage, [](auto value) { do_not_optimize(value); return value; });
+                    storage.seek(record_bytes);
+                }
+            }));
+
+            report("lens_modify_many", measure(opts.repetitions, [&] {
+                decltype(auto) storage = backend.reader();
+                blob::lens_modify_many<traits::lens_member>(storage, count, [](auto value) { do_not_optimize(value); return value; });
+            }));
+        }
+    }
+}
+
+template<typename T>
+void run_shape(const options& opts) {
+    std::vector<T> records;
+    records.reserve(opts.num_records);
+    for (std::size_t i = 0; i < opts.num_records; ++i) {
+        records.push_back(shape_traits<T>::make(i));
+    }
+
+    std::vector<std::byte> data(blob::detail::total_serialized_size<T>() * records.size());
+    blob::store_many(blob::memory_storage { data.data(), data.data(), data.data() + data.size() }, records);
+
+    {
+        memory_backend backend { data };
+        run_backend(opts, records, backend);
+    }
+    {
+        checked_memory_backend backend { data };
+        run_backend(opts, records, backend);
+    }
+    {
+        hashing_backend backend { data };
+        run_backend(opts, records, backend);
+    }
+    {
+        vector_backend backend;
+        run_backend(opts, records, backend);
+    }
+    if (opts.read_latency.count() == 0) {
+        // Reading each member individually is dominated by the latency, if any
+        stream_backend backend { data, opts.read_latency };
+        run_backend(opts, records, backend);
+    }
+    {
+        buffered_stream_backend backend { data, opts.read_latency };
+        run_backend(opts, records, backend);
+    }
+    {
+        readahead_stream_backend backend { data, opts.read_latency };
+        run_backend(opts, records, backend);
+    }
+    {
+        type_erased_backend backend { data };
+        run_backend(opts, records, backend);
+    }
+#if !defined(_WIN32)
+    {
+        mmap_backend backend { data };
+        run_backend(opts, records, backend);
+    }
+    {
+        fd_backend backend;
+        run_backend(opts, records, backend);
+    }
+#endif
+}
+
+options parse_options(int argc, char* argv[]) {
+    options opts;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--records" && i + 1 < argc) {
+            opts.num_records = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            opts.repetitions = std::max<std::size_t>(std::strtoull(argv[++i], nullptr, 10), 1);
+        } else if (arg == "--format" && i + 1 < argc) {
+            opts.json = (std::string { argv[++i] } == "json");
+        } else if (arg == "--read-latency-us" && i + 1 < argc) {
+            opts.read_latency = std::chrono::microseconds { std::strtoll(argv[++i], nullptr, 10) };
+        } else if (arg == "--threads" && i + 1 < argc) {
+            opts.num_threads = std::max<std::size_t>(std::strtoull(argv[++i], nullptr, 10), 1);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--records N] [--repetitions N] [--format csv|json] [--read-latency-us N] [--threads N]" << std::endl;
+            std::exit(1);
+        }
+    }
+    return opts;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    auto opts = parse_options(argc, argv);
+
+    try {
+        print_header(opts);
+        run_shape<Narrow>(opts);
+        run_shape<Wide>(opts);
+        run_shape<Nested>(opts);
+        run_shape<ArrayHeavy>(opts);
+        run_shape<ValidationHeavy>(opts);
+        run_shape<Vertex>(opts);
+    } catch (std::exception& err) {
+        std::cerr << "Benchmark failed: " << err.what() << std::endl;
+        return 1;
+    } catch (const blob::exception&) {
+        // Library exceptions don't derive from std::exception
+        std::cerr << "Benchmark failed: blobify exception (corrupt or truncated data)" << std::endl;
+        return 1;
+    }
+}
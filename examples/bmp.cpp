@@ -78,7 +78,7 @@ int main(int argc, char* argv[]) {
     }
 
     try {
-        blob::istream_storage file_blob { file };
+        blob::buffered_istream_storage file_blob { file };
 
         auto header = blob::load<BMP::Header>(file_blob);
         auto secondary_header = blob::load<BMP::SecondaryHeaderV4>(file_blob);
@@ -2,6 +2,10 @@
 #define BLOBIFY_CONSTRUCTION_POLICY_HPP
 
 #include "endian.hpp"
+#include "properties.hpp"
+
+#include "detail/bit_cast.hpp"
+#include "detail/byteswap.hpp"
 
 #include <type_traits>
 
@@ -30,29 +34,87 @@ namespace detail {
  * Performs simple source<->host endianness conversion
  *
  * With this default policy, T must be convertible from/to Representative.
+ * Floating-point values are bit-cast from/to their (unsigned integral) Representative.
  */
 struct default_construction_policy : construction_policy {
     template<typename T, typename Representative, endian SourceEndianness>
     static T decode(Representative source) {
-        static_assert(SourceEndianness == endian::native,
-                      "Endianness conversion not currently supported by DefaultConstructionPolicy");
-        return T { source };
+        static_assert(SourceEndianness == endian::little || SourceEndianness == endian::big,
+                      "Unsupported source endianness");
+        if constexpr (SourceEndianness != endian::native) {
+            source = byteswap(source);
+        }
+        if constexpr (std::is_floating_point_v<T>) {
+            return bit_cast<T>(source);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            return source != 0;
+        } else {
+            return T { source };
+        }
     }
 
     template<typename Representative, typename T, endian TargetEndianness>
     static Representative encode(const T& value) {
-        static_assert(TargetEndianness == endian::native,
-                      "Endianness conversion not currently supported by DefaultConstructionPolicy");
+        static_assert(TargetEndianness == endian::little || TargetEndianness == endian::big,
+                      "Unsupported target endianness");
+        Representative representative;
         if constexpr (std::is_enum_v<T>) {
             // Directly cast enum to integer
-            return static_cast<Representative>(value);
+            representative = static_cast<Representative>(value);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            representative = bit_cast<Representative>(value);
         } else {
             // Use brace-initialization to allow for constructors to be called (if any)
-            return Representative { value };
+            representative = Representative { value };
+        }
+
+        if constexpr (TargetEndianness != endian::native) {
+            representative = byteswap(representative);
         }
+        return representative;
     }
 };
 
+/**
+ * Adaptor for loading data that has been checked against its validation
+ * properties before (e.g. by try_load). Loads using this policy decode
+ * values like ConstructionPolicy but skip all validation checks.
+ */
+template<typename ConstructionPolicy>
+struct prevalidated_policy : ConstructionPolicy { };
+
+template<typename ConstructionPolicy>
+struct policy_traits {
+    using base_policy = ConstructionPolicy;
+    static constexpr bool validates = true;
+};
+
+template<typename ConstructionPolicy>
+struct policy_traits<prevalidated_policy<ConstructionPolicy>> {
+    using base_policy = ConstructionPolicy;
+    static constexpr bool validates = false;
+};
+
+/**
+ * Checks if elements of type T may be transferred by copying their object
+ * representation rather than decoding/encoding each element individually
+ */
+template<typename ConstructionPolicy, typename T, auto member_props>
+inline constexpr bool can_bulk_transfer_v =
+        std::is_same_v<typename policy_traits<ConstructionPolicy>::base_policy, default_construction_policy> &&
+        is_trivially_blobifiable_element<T, member_props, policy_traits<ConstructionPolicy>::validates>();
+
+/**
+ * Checks if elementary values of type T may be decoded/encoded by copying
+ * their object representation and reversing the byte order of each element
+ * if the serialized endianness is not native. Unlike can_bulk_transfer_v,
+ * this doesn't take validation into account.
+ */
+template<typename ConstructionPolicy, typename T>
+inline constexpr bool can_bulk_decode_v =
+        std::is_same_v<typename policy_traits<ConstructionPolicy>::base_policy, default_construction_policy> &&
+        is_plain_representation_v<T>;
+
 } // namespace detail
 
 } // namespace blob
@@ -0,0 +1,38 @@
+#ifndef BLOBIFY_BIT_CAST_HPP
+#define BLOBIFY_BIT_CAST_HPP
+
+#include <cstring>
+#include <type_traits>
+
+#if __cplusplus > 201703L && __has_include(<bit>)
+#include <bit>
+#endif
+
+namespace blob::detail {
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_bit_cast)
+#define BLOBIFY_HAS_BUILTIN_BIT_CAST 1
+#endif
+#endif
+
+/// Reinterprets the object representation of source as a value of type To (like C++20 std::bit_cast)
+template<typename To, typename From>
+constexpr To bit_cast(const From& source) {
+    static_assert(sizeof(To) == sizeof(From), "bit_cast requires types of equal size");
+    static_assert(std::is_trivially_copyable_v<To> && std::is_trivially_copyable_v<From>, "bit_cast requires trivially copyable types");
+
+#if defined(__cpp_lib_bit_cast)
+    return std::bit_cast<To>(source);
+#elif defined(BLOBIFY_HAS_BUILTIN_BIT_CAST)
+    return __builtin_bit_cast(To, source);
+#else
+    To result;
+    std::memcpy(&result, &source, sizeof(To));
+    return result;
+#endif
+}
+
+} // namespace blob::detail
+
+#endif // BLOBIFY_BIT_CAST_HPP
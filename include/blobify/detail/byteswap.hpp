@@ -0,0 +1,125 @@
+#ifndef BLOBIFY_BYTESWAP_HPP
+#define BLOBIFY_BYTESWAP_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+namespace blob::detail {
+
+/// Reverses the byte order of the given integral value
+template<typename T>
+constexpr T byteswap(T value) {
+    static_assert(std::is_integral_v<T>, "byteswap requires an integral type");
+
+    using unsigned_type = std::make_unsigned_t<T>;
+    auto bits = static_cast<unsigned_type>(value);
+    if constexpr (sizeof(T) == 1) {
+        return value;
+    } else if constexpr (sizeof(T) == 2) {
+#if defined(_MSC_VER)
+        return static_cast<T>(_byteswap_ushort(bits));
+#else
+        return static_cast<T>(__builtin_bswap16(bits));
+#endif
+    } else if constexpr (sizeof(T) == 4) {
+#if defined(_MSC_VER)
+        return static_cast<T>(_byteswap_ulong(bits));
+#else
+        return static_cast<T>(__builtin_bswap32(bits));
+#endif
+    } else if constexpr (sizeof(T) == 8) {
+#if defined(_MSC_VER)
+        return static_cast<T>(_byteswap_uint64(bits));
+#else
+        return static_cast<T>(__builtin_bswap64(bits));
+#endif
+    } else {
+        static_assert(!sizeof(T), "Unexpected size of integral type");
+    }
+}
+
+/// Byte shuffle pattern that reverses each ElementSize-sized group within a 16-byte block
+template<std::size_t ElementSize>
+inline constexpr auto byteswap_shuffle_mask = [] {
+    std::array<std::uint8_t, 16> mask { };
+    for (std::size_t i = 0; i < mask.size(); ++i) {
+        mask[i] = static_cast<std::uint8_t>(i - i % ElementSize + (ElementSize - 1 - i % ElementSize));
+    }
+    return mask;
+}();
+
+/**
+ * Copies count elements of size ElementSize from source to dest while reversing
+ * the byte order of each element. source and dest may be equal for in-place
+ * operation, but may not otherwise overlap.
+ */
+template<std::size_t ElementSize>
+inline void byteswap_copy_bytes(std::byte* dest, const std::byte* source, std::size_t count) {
+    static_assert(ElementSize == 2 || ElementSize == 4 || ElementSize == 8, "Unsupported element size");
+
+    std::size_t offset = 0;
+    const std::size_t num_bytes = count * ElementSize;
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+    const auto mask128 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(byteswap_shuffle_mask<ElementSize>.data()));
+#endif
+#if defined(__AVX2__)
+    const auto mask256 = _mm256_broadcastsi128_si256(mask128);
+    for (; offset + 32 <= num_bytes; offset += 32) {
+        auto data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + offset));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + offset), _mm256_shuffle_epi8(data, mask256));
+    }
+#endif
+#if defined(__AVX2__) || defined(__SSSE3__)
+    for (; offset + 16 <= num_bytes; offset += 16) {
+        auto data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + offset));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + offset), _mm_shuffle_epi8(data, mask128));
+    }
+#endif
+
+    // Scalar fallback for the remaining elements
+    using word_type = std::conditional_t<ElementSize == 2, std::uint16_t,
+                      std::conditional_t<ElementSize == 4, std::uint32_t, std::uint64_t>>;
+    for (; offset < num_bytes; offset += ElementSize) {
+        word_type word;
+        std::memcpy(&word, source + offset, ElementSize);
+        word = byteswap(word);
+        std::memcpy(dest + offset, &word, ElementSize);
+    }
+}
+
+/// Reverses the byte order of each of the given count elements in-place
+template<typename T>
+inline void byteswap_n(T* data, std::size_t count) {
+    if constexpr (sizeof(T) > 1) {
+        auto bytes = reinterpret_cast<std::byte*>(data);
+        byteswap_copy_bytes<sizeof(T)>(bytes, bytes, count);
+    }
+}
+
+/// Copies the byte representation of count elements to dest, reversing the byte order of each element
+template<typename T>
+inline void byteswap_copy_n(std::byte* dest, const T* source, std::size_t count) {
+    if constexpr (sizeof(T) > 1) {
+        byteswap_copy_bytes<sizeof(T)>(dest, reinterpret_cast<const std::byte*>(source), count);
+    } else {
+        std::memcpy(dest, source, count);
+    }
+}
+
+} // namespace blob::detail
+
+#endif // BLOBIFY_BYTESWAP_HPP
@@ -0,0 +1,146 @@
+#ifndef BLOBIFY_CRC32C_HPP
+#define BLOBIFY_CRC32C_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define BLOBIFY_HAS_SSE42_CRC32C 1
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define BLOBIFY_HAS_ARM_CRC32C 1
+#endif
+
+namespace blob::detail {
+
+/// Lookup tables for slicing-by-8 computation of CRC32C (Castagnoli polynomial, reflected)
+inline constexpr auto crc32c_tables = [] {
+    std::array<std::array<std::uint32_t, 256>, 8> tables { };
+    for (std::uint32_t byte = 0; byte < 256; ++byte) {
+        std::uint32_t crc = byte;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ ((crc & 1) ? 0x82f63b78 : 0);
+        }
+        tables[0][byte] = crc;
+    }
+    for (std::uint32_t byte = 0; byte < 256; ++byte) {
+        for (std::size_t table = 1; table < tables.size(); ++table) {
+            auto prev = tables[table - 1][byte];
+            tables[table][byte] = (prev >> 8) ^ tables[0][prev & 0xff];
+        }
+    }
+    return tables;
+}();
+
+inline std::uint32_t crc32c_update_software(std::uint32_t crc, const std::byte* data, std::size_t num_bytes) {
+    auto& t = crc32c_tables;
+    while (num_bytes >= 8) {
+        std::uint32_t low, high;
+        std::memcpy(&low, data, 4);
+        std::memcpy(&high, data + 4, 4);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        low = __builtin_bswap32(low);
+        high = __builtin_bswap32(high);
+#endif
+        low ^= crc;
+        crc = t[7][low & 0xff] ^ t[6][(low >> 8) & 0xff] ^ t[5][(low >> 16) & 0xff] ^ t[4][low >> 24] ^
+              t[3][high & 0xff] ^ t[2][(high >> 8) & 0xff] ^ t[1][(high >> 16) & 0xff] ^ t[0][high >> 24];
+        data += 8;
+        num_bytes -= 8;
+    }
+    while (num_bytes--) {
+        crc = (crc >> 8) ^ t[0][(crc ^ static_cast<std::uint8_t>(*data++)) & 0xff];
+    }
+    return crc;
+}
+
+#if defined(BLOBIFY_HAS_SSE42_CRC32C)
+__attribute__((target("sse4.2")))
+inline std::uint32_t crc32c_update_hardware(std::uint32_t crc, const std::byte* data, std::size_t num_bytes) {
+#if defined(__x86_64__)
+    while (num_bytes >= 8) {
+        std::uint64_t chunk;
+        std::memcpy(&chunk, data, 8);
+        crc = static_cast<std::uint32_t>(_mm_crc32_u64(crc, chunk));
+        data += 8;
+        num_bytes -= 8;
+    }
+#endif
+    while (num_bytes >= 4) {
+        std::uint32_t chunk;
+        std::memcpy(&chunk, data, 4);
+        crc = _mm_crc32_u32(crc, chunk);
+        data += 4;
+        num_bytes -= 4;
+    }
+    if (num_bytes >= 2) {
+        std::uint16_t chunk;
+        std::memcpy(&chunk, data, 2);
+        crc = _mm_crc32_u16(crc, chunk);
+        data += 2;
+        num_bytes -= 2;
+    }
+    if (num_bytes) {
+        crc = _mm_crc32_u8(crc, static_cast<std::uint8_t>(*data));
+    }
+    return crc;
+}
+
+#if !defined(__SSE4_2__)
+inline const bool cpu_has_sse42 = __builtin_cpu_supports("sse4.2");
+#endif
+#elif defined(BLOBIFY_HAS_ARM_CRC32C)
+inline std::uint32_t crc32c_update_hardware(std::uint32_t crc, const std::byte* data, std::size_t num_bytes) {
+    while (num_bytes >= 8) {
+        std::uint64_t chunk;
+        std::memcpy(&chunk, data, 8);
+        crc = __crc32cd(crc, chunk);
+        data += 8;
+        num_bytes -= 8;
+    }
+    if (num_bytes >= 4) {
+        std::uint32_t chunk;
+        std::memcpy(&chunk, data, 4);
+        crc = __crc32cw(crc, chunk);
+        data += 4;
+        num_bytes -= 4;
+    }
+    if (num_bytes >= 2) {
+        std::uint16_t chunk;
+        std::memcpy(&chunk, data, 2);
+        crc = __crc32ch(crc, chunk);
+        data += 2;
+        num_bytes -= 2;
+    }
+    if (num_bytes) {
+        crc = __crc32cb(crc, static_cast<std::uint8_t>(*data));
+    }
+    return crc;
+}
+#endif
+
+/**
+ * Updates the (non-inverted) CRC32C state crc with the given data.
+ *
+ * This uses the CRC32 instructions of SSE4.2 or ARMv8 where available. On x86
+ * builds that don't enable SSE4.2, support is detected at runtime.
+ */
+inline std::uint32_t crc32c_update(std::uint32_t crc, const std::byte* data, std::size_t num_bytes) {
+#if defined(BLOBIFY_HAS_ARM_CRC32C) || (defined(BLOBIFY_HAS_SSE42_CRC32C) && defined(__SSE4_2__))
+    return crc32c_update_hardware(crc, data, num_bytes);
+#elif defined(BLOBIFY_HAS_SSE42_CRC32C)
+    if (cpu_has_sse42) {
+        return crc32c_update_hardware(crc, data, num_bytes);
+    }
+    return crc32c_update_software(crc, data, num_bytes);
+#else
+    return crc32c_update_software(crc, data, num_bytes);
+#endif
+}
+
+} // namespace blob::detail
+
+#endif // BLOBIFY_CRC32C_HPP
@@ -16,6 +16,20 @@ struct is_std_array<std::array<T, N>> : std::true_type {};
 template<typename T>
 inline constexpr auto is_std_array_v = is_std_array<T>::value;
 
+/// Element type for std::array, T itself otherwise
+template<typename T>
+struct array_element {
+    using type = T;
+};
+
+template<typename T, std::size_t N>
+struct array_element<std::array<T, N>> {
+    using type = T;
+};
+
+template<typename T>
+using array_element_t = typename array_element<T>::type;
+
 } // namespace blob::detail
 
 #endif // BLOBIFY_IS_ARRAY_HPP
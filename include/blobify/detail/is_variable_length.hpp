@@ -0,0 +1,94 @@
+#ifndef BLOBIFY_IS_VARIABLE_LENGTH_HPP
+#define BLOBIFY_IS_VARIABLE_LENGTH_HPP
+
+#include "is_array.hpp"
+
+#include <boost/pfr/core.hpp>
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __cplusplus > 201703L && __has_include(<span>)
+#include <span>
+#endif
+
+namespace blob::detail {
+
+/// Checks if T is a non-owning view of contiguous elements (std::basic_string_view or std::span)
+template<typename T>
+struct is_variable_length_view : std::false_type {};
+
+template<typename CharT, typename Traits>
+struct is_variable_length_view<std::basic_string_view<CharT, Traits>> : std::true_type {};
+
+#if defined(__cpp_lib_span)
+template<typename T>
+struct is_variable_length_view<std::span<T, std::dynamic_extent>> : std::true_type {};
+#endif
+
+template<typename T>
+inline constexpr auto is_variable_length_view_v = is_variable_length_view<T>::value;
+
+/// Checks if T is a container whose number of elements is determined at runtime
+template<typename T>
+struct is_variable_length : is_variable_length_view<T> {};
+
+template<typename T, typename Allocator>
+struct is_variable_length<std::vector<T, Allocator>> : std::true_type {};
+
+template<typename CharT, typename Traits, typename Allocator>
+struct is_variable_length<std::basic_string<CharT, Traits, Allocator>> : std::true_type {};
+
+template<typename T>
+inline constexpr auto is_variable_length_v = is_variable_length<T>::value;
+
+template<typename T>
+constexpr bool contains_variable_length();
+
+template<typename T, std::size_t... Idxs>
+constexpr bool has_variable_length_members(std::index_sequence<Idxs...>) {
+    return (false || ... || contains_variable_length<boost::pfr::tuple_element_t<Idxs, T>>());
+}
+
+/// Checks if T is variable-length or (recursively) contains a variable-length member
+template<typename T>
+constexpr bool contains_variable_length() {
+    if constexpr (is_variable_length_v<T>) {
+        return true;
+    } else if constexpr (is_std_array_v<T>) {
+        return contains_variable_length<typename T::value_type>();
+    } else if constexpr (std::is_class_v<T>) {
+        return has_variable_length_members<T>(std::make_index_sequence<boost::pfr::tuple_size_v<T>> { });
+    } else {
+        return false;
+    }
+}
+
+template<typename T, typename Allocator>
+struct array_element<std::vector<T, Allocator>> {
+    using type = T;
+};
+
+template<typename CharT, typename Traits, typename Allocator>
+struct array_element<std::basic_string<CharT, Traits, Allocator>> {
+    using type = CharT;
+};
+
+template<typename CharT, typename Traits>
+struct array_element<std::basic_string_view<CharT, Traits>> {
+    using type = CharT;
+};
+
+#if defined(__cpp_lib_span)
+template<typename T>
+struct array_element<std::span<T, std::dynamic_extent>> {
+    using type = std::remove_cv_t<T>;
+};
+#endif
+
+} // namespace blob::detail
+
+#endif // BLOBIFY_IS_VARIABLE_LENGTH_HPP
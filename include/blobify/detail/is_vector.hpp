@@ -0,0 +1,20 @@
+#ifndef BLOBIFY_IS_VECTOR_HPP
+#define BLOBIFY_IS_VECTOR_HPP
+
+#include <type_traits>
+#include <vector>
+
+namespace blob::detail {
+
+template<typename T>
+struct is_std_vector : std::false_type {};
+
+template<typename T, typename Allocator>
+struct is_std_vector<std::vector<T, Allocator>> : std::true_type {};
+
+template<typename T>
+inline constexpr auto is_std_vector_v = is_std_vector<T>::value;
+
+} // namespace blob::detail
+
+#endif // BLOBIFY_IS_VECTOR_HPP
@@ -3,7 +3,9 @@
 
 #include <boost/pfr/core.hpp>
 
+#include <array>
 #include <cstddef>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -20,13 +22,36 @@ struct pmd_traits_t<Member> {
     using member_type = MemberType;
 };
 
+/// Addresses of all members of the given aggregate, in declaration order
+template<typename T, std::size_t... Idxs>
+constexpr auto member_addresses(const T& t, std::index_sequence<Idxs...>) {
+    auto members = boost::pfr::structure_tie(t);
+    return std::array<const void*, sizeof...(Idxs)> { static_cast<const void*>(&std::get<Idxs>(members))... };
+}
+
 template<typename T, auto PointerToMember, std::size_t... Idxs>
-constexpr auto pmd_to_member_index(std::index_sequence<Idxs...>) {
-    std::size_t index = -1;
-    auto t = declval(make_tag<T>);
-    // Iterate over all members and check which one matches
-    ((static_cast<void*>(&boost::pfr::get<Idxs>(t)) == static_cast<void*>(&(t.*PointerToMember)) && (index = Idxs)), ...);
-    return index;
+constexpr auto pmd_to_member_index(std::index_sequence<Idxs...> index_sequence) {
+    using member_type = typename pmd_traits_t<PointerToMember>::member_type;
+    constexpr std::size_t num_type_matches = (std::size_t { 0 } + ... + std::is_same_v<boost::pfr::tuple_element_t<Idxs, T>, member_type>);
+    if constexpr (num_type_matches == 1) {
+        // Only one member has the given type, so no placeholder object needs
+        // to be constructed. This allows for members that aren't literal
+        // types (such as std::vector) prior to C++20
+        std::size_t index = 0;
+        ((index = std::is_same_v<boost::pfr::tuple_element_t<Idxs, T>, member_type> ? Idxs : index), ...);
+        return index;
+    } else {
+        auto t = declval(make_tag<T>);
+        // Check which member matches. The address lookup is shared between all
+        // members of T, so this doesn't instantiate any per-member templates
+        auto addresses = member_addresses(t, index_sequence);
+        for (std::size_t index = 0; index < addresses.size(); ++index) {
+            if (addresses[index] == static_cast<const void*>(&(t.*PointerToMember))) {
+                return index;
+            }
+        }
+        return static_cast<std::size_t>(-1);
+    }
 }
 
 template<typename SFINAE, typename Data, typename... PointersToMember>
@@ -1,9 +1,12 @@
 #ifndef BLOBIFY_EXCEPTIONS_HPP
 #define BLOBIFY_EXCEPTIONS_HPP
 
+#include "detail/is_array.hpp"
+#include "detail/is_variable_length.hpp"
 #include "detail/pmd_traits.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 namespace blob {
@@ -34,10 +37,11 @@ struct invalid_enum_value_exception : exception {
     }
 };
 
+/// For std::array members, this reports the offending array element
 template<auto PointerToMember>
 struct invalid_enum_value_exception_for
-        : invalid_enum_value_exception<typename detail::pmd_traits_t<PointerToMember>::member_type> {
-    using generic_exception_type = invalid_enum_value_exception<typename detail::pmd_traits_t<PointerToMember>::member_type>;
+        : invalid_enum_value_exception<detail::array_element_t<typename detail::pmd_traits_t<PointerToMember>::member_type>> {
+    using generic_exception_type = invalid_enum_value_exception<detail::array_element_t<typename detail::pmd_traits_t<PointerToMember>::member_type>>;
     using enum_type = typename generic_exception_type::enum_type;
 
     invalid_enum_value_exception_for(enum_type actual)
@@ -52,6 +56,52 @@ struct invalid_enum_value_exception_for
  */
 struct storage_exhausted_exception : exception { };
 
+/**
+ * Thrown when the number of elements of a variable-length member can't be
+ * represented: On load, the count member holds a negative value. On store,
+ * the number of elements doesn't fit into the count member, or differs
+ * between variable-length members that share the same count member.
+ */
+struct invalid_length_exception : exception {
+    std::size_t length;
+
+    invalid_length_exception(std::size_t length)
+        : length(length) {
+    }
+};
+
+/**
+ * Thrown when a checksum computed over the loaded data doesn't match the
+ * checksum stored along with it
+ */
+struct checksum_mismatch_exception : exception {
+    std::uint64_t expected_value;
+    std::uint64_t actual_value;
+
+    checksum_mismatch_exception(std::uint64_t expected, std::uint64_t actual)
+        : expected_value(expected), actual_value(actual) {
+    }
+};
+
+/**
+ * Thrown when a view member (such as std::span) can't refer to the
+ * serialized elements in place because they aren't suitably aligned in memory
+ */
+struct misaligned_view_exception : exception { };
+
+/**
+ * Thrown when a storage backend fails to acquire or resize its underlying
+ * resource, e.g. because a file could not be opened or mapped into memory.
+ */
+struct storage_io_exception : exception {
+    /// Platform-specific error number (errno) describing the failure
+    int error_code;
+
+    storage_io_exception(int error_code)
+        : error_code(error_code) {
+    }
+};
+
 } // namespace blob
 
 #endif // BLOBIFY_EXCEPTIONS_HPP
@@ -0,0 +1,206 @@
+#ifndef BLOBIFY_FD_STORAGE_HPP
+#define BLOBIFY_FD_STORAGE_HPP
+
+#if defined(_WIN32)
+#error "fd_ostream_storage is only available on POSIX platforms"
+#endif
+
+#include "exceptions.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace blob {
+
+/**
+ * Output storage backend writing to a POSIX file descriptor using
+ * scatter-gather I/O.
+ *
+ * Small stores are collected in an internal buffer. Larger ranges of the
+ * stored data (such as std::array members or std::vector contents with
+ * matching in-memory layout) are referenced directly rather than copied. All
+ * pending ranges are written using a single writev() once flush_threshold
+ * bytes have accumulated, or at the end of a top-level operation if it
+ * referenced any of its input data.
+ *
+ * Hence, storing many small records only requires one system call per
+ * flush_threshold bytes. Buffered data is written upon destruction. Call
+ * flush() explicitly to be notified of errors.
+ *
+ * @note The file descriptor is not owned by the storage
+ */
+class fd_ostream_storage {
+public:
+    static constexpr std::size_t default_flush_threshold = 64 * 1024;
+
+    /// Stores of at least this many bytes from the input data are referenced rather than copied
+    static constexpr std::size_t min_borrow_size = 256;
+
+    explicit fd_ostream_storage(int fd, std::size_t flush_threshold = default_flush_threshold)
+        : fd(fd), buffer(std::make_unique<std::byte[]>(flush_threshold)), flush_threshold(flush_threshold) {
+    }
+
+    fd_ostream_storage(const fd_ostream_storage&) = delete;
+    fd_ostream_storage& operator=(const fd_ostream_storage&) = delete;
+
+    ~fd_ostream_storage() {
+        try {
+            flush();
+        } catch (...) {
+            // Errors can't be reported from the destructor. This includes
+            // std::bad_alloc thrown when recording the buffered range
+        }
+    }
+
+    /**
+     * Writes all pending data to the file descriptor
+     * @throws storage_exhausted_exception if the device is out of space
+     * @throws storage_io_exception on other write errors
+     */
+    void flush() {
+        commit_buffer();
+        auto ranges = pending.data();
+        auto num_ranges = pending.size();
+        while (num_ranges) {
+            auto result = ::writev(fd, ranges, static_cast<int>(std::min(num_ranges, max_ranges)));
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                auto error = errno;
+                clear_pending();
+                if (error == ENOSPC || error == EFBIG) {
+                    throw storage_exhausted_exception { };
+                }
+                throw storage_io_exception { error };
+            }
+
+            // Skip over the written ranges and continue after partial writes
+            auto num_written = static_cast<std::size_t>(result);
+            while (num_ranges && num_written >= ranges->iov_len) {
+                num_written -= ranges->iov_len;
+                ++ranges;
+                --num_ranges;
+            }
+            if (num_ranges) {
+                ranges->iov_base = static_cast<std::byte*>(ranges->iov_base) + num_written;
+                ranges->iov_len -= num_written;
+            }
+        }
+        clear_pending();
+    }
+
+    /**
+     * Flushes pending data and moves the file offset of the descriptor
+     * @throws storage_io_exception if the file descriptor isn't seekable
+     */
+    void seek(std::ptrdiff_t num_bytes) {
+        flush();
+        if (::lseek(fd, num_bytes, SEEK_CUR) < 0) {
+            throw storage_io_exception { errno };
+        }
+    }
+
+    void store(std::byte* source, std::size_t num_bytes) {
+        if (num_bytes > flush_threshold - buffer_size) {
+            flush();
+            if (num_bytes >= flush_threshold) {
+                add_range(source, num_bytes);
+                flush();
+                return;
+            }
+        }
+
+        std::memcpy(buffer.get() + buffer_size, source, num_bytes);
+        buffer_size += num_bytes;
+    }
+
+    void store_borrowed(const std::byte* source, std::size_t num_bytes) {
+        if (num_bytes < min_borrow_size) {
+            // Copying is cheaper than writing an extra range
+            store(const_cast<std::byte*>(source), num_bytes);
+            return;
+        }
+
+        // Adding this range may also add a range for the buffered data
+        if (pending.size() + 2 > max_ranges) {
+            flush();
+        }
+        commit_buffer();
+        add_range(source, num_bytes);
+        has_borrowed = true;
+        if (pending_bytes >= flush_threshold) {
+            flush();
+        }
+    }
+
+    /// Writes out pending data if it references any input data of the current operation
+    void release_borrowed() {
+        if (has_borrowed) {
+            flush();
+        }
+    }
+
+private:
+#if defined(IOV_MAX)
+    static constexpr std::size_t max_ranges = IOV_MAX;
+#else
+    static constexpr std::size_t max_ranges = 1024;
+#endif
+
+    /// Adds a range for the data buffered since the last call
+    void commit_buffer() {
+        if (buffer_size != committed_size) {
+            add_range(buffer.get() + committed_size, buffer_size - committed_size);
+            committed_size = buffer_size;
+        }
+    }
+
+    /// @pre Fewer than max_ranges ranges are pending
+    void add_range(const std::byte* source, std::size_t num_bytes) {
+        if (!pending.empty() && static_cast<const std::byte*>(pending.back().iov_base) + pending.back().iov_len == source) {
+            // Extend the previous range, e.g. for adjacent elements of borrowed data
+            pending.back().iov_len += num_bytes;
+        } else if (num_bytes) {
+            // NOTE: iovec doesn't use a const pointer, but writev doesn't modify the source data
+            pending.push_back(iovec { const_cast<std::byte*>(source), num_bytes });
+        }
+        pending_bytes += num_bytes;
+    }
+
+    void clear_pending() {
+        pending.clear();
+        pending_bytes = 0;
+        buffer_size = committed_size = 0;
+        has_borrowed = false;
+    }
+
+    int fd;
+    std::unique_ptr<std::byte[]> buffer;
+    std::size_t flush_threshold;
+
+    // Number of bytes used in the buffer
+    std::size_t buffer_size = 0;
+
+    // Number of buffered bytes covered by the pending ranges
+    std::size_t committed_size = 0;
+
+    // Ranges to be written on the next flush, referring to the buffer or to borrowed input data
+    std::vector<iovec> pending;
+    std::size_t pending_bytes = 0;
+
+    // Whether any of the pending ranges refer to input data of the current operation
+    bool has_borrowed = false;
+};
+
+} // namespace blob
+
+#endif // BLOBIFY_FD_STORAGE_HPP
@@ -0,0 +1,220 @@
+#ifndef BLOBIFY_HASHING_STORAGE_HPP
+#define BLOBIFY_HASHING_STORAGE_HPP
+
+#include "exceptions.hpp"
+#include "memory_storage.hpp"
+#include "storage_backend.hpp"
+
+#include "detail/crc32c.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace blob {
+
+/**
+ * CRC32C (Castagnoli) checksum, computed using hardware instructions where available.
+ *
+ * Other hash functions (such as xxHash) can be used with hashing_storage by
+ * providing a type with the same interface.
+ */
+struct crc32c {
+    using value_type = std::uint32_t;
+
+    void update(const std::byte* data, std::size_t num_bytes) {
+        state = detail::crc32c_update(state, data, num_bytes);
+    }
+
+    value_type digest() const {
+        return ~state;
+    }
+
+    void reset() {
+        state = ~value_type { 0 };
+    }
+
+private:
+    value_type state = ~value_type { 0 };
+};
+
+namespace detail {
+
+/**
+ * Unchecked view of a contiguous storage, used by hashing_storage for the
+ * duration of a single top-level operation.
+ *
+ * Rather than hashing each member access, the range between the start of the
+ * operation (or the last seek) and the cursor is hashed as a whole when
+ * seeking and when the view is destroyed, which also updates the cursor of the
+ * underlying storage. Operations on many elements additionally hash the range
+ * at checkpoints every checkpoint_interval bytes, while it's still in cache.
+ *
+ * Data accessed in place (such as views or in-place checks) is accounted for
+ * by advancing current directly, whereas seek() passes over data.
+ */
+template<typename Hasher>
+class hashing_memory_view : public memory_storage {
+public:
+    // NOTE: The buffer of the view starts at the cursor rather than copying
+    //       buffer_begin, since loading it along with current stalls on the
+    //       cursor update at the end of the preceding operation
+    hashing_memory_view(memory_storage& base, Hasher& hasher)
+        : memory_storage { base.current, base.current, base.buffer_end }, base(base), hasher(hasher), range_begin(base.current) {
+    }
+
+    hashing_memory_view(const hashing_memory_view&) = delete;
+    hashing_memory_view& operator=(const hashing_memory_view&) = delete;
+
+    ~hashing_memory_view() {
+        hash_range();
+        base.current = current;
+    }
+
+    /// Hashing ranges larger than this would reread data that has left the L1 cache
+    static constexpr std::size_t checkpoint_interval = 16 * 1024;
+
+    void checkpoint() {
+        if (static_cast<std::size_t>(current - range_begin) >= checkpoint_interval) {
+            hash_range();
+            range_begin = current;
+        }
+    }
+
+    // Hides memory_storage::seek so that data passed over isn't hashed
+    void seek(std::ptrdiff_t num_bytes) {
+        hash_range();
+        memory_storage::seek(num_bytes);
+        range_begin = current;
+    }
+
+private:
+    void hash_range() {
+        if (current > range_begin) {
+            hasher.update(range_begin, static_cast<std::size_t>(current - range_begin));
+        }
+    }
+
+    memory_storage& base;
+    Hasher& hasher;
+
+    // Beginning of the accessed range that hasn't been hashed yet
+    std::byte* range_begin;
+};
+
+} // namespace detail
+
+/**
+ * Storage adapter that computes a checksum over all bytes loaded from or
+ * stored to the underlying storage, without requiring a separate pass over
+ * the serialized data.
+ *
+ * Only the bytes actually loaded or stored are hashed, so the checksum
+ * doesn't depend on the underlying storage: Each chunk of data is hashed
+ * right after loading or right before storing it, and data passed over by
+ * seek() (such as the other members of a blob accessed by lens_load) is
+ * skipped.
+ *
+ * On contiguous storages, top-level operations access the memory directly
+ * and hash each range accessed between seeks in a single pass, split into
+ * chunks of a few KiB for operations on many elements. Data modified
+ * in place by lens_modify isn't hashed, since it's not accessed through the
+ * cursor.
+ *
+ * To check data against a stored checksum, load the covered data through the
+ * hashing_storage and the checksum itself from the underlying storage, then
+ * call verify().
+ */
+template<typename Storage, typename Hasher = crc32c>
+class hashing_storage {
+public:
+    explicit hashing_storage(Storage& storage, Hasher hasher = { })
+        : storage(storage), hasher(std::move(hasher)) {
+    }
+
+    // Copies would share the cursor of the underlying storage, but not the hash state
+    hashing_storage(const hashing_storage&) = delete;
+    hashing_storage& operator=(const hashing_storage&) = delete;
+
+    /// Checks the bounds of a top-level operation on bounds-checked storages
+    template<typename S = Storage, typename = std::enable_if_t<detail::is_bounds_checked_storage_v<S> || detail::is_contiguous_storage_v<S>>>
+    void require(std::size_t num_bytes) {
+        detail::checked_access(storage, num_bytes);
+    }
+
+    /// Variant of require() for storing data, which rejects stores to read-only storages
+    template<typename S = Storage, typename = std::enable_if_t<detail::is_bounds_checked_storage_v<S>>>
+    void require_store(std::size_t num_bytes) {
+        detail::checked_store_access(storage, num_bytes);
+    }
+
+    /**
+     * For contiguous storages, returns a view on their memory that hashes the
+     * accessed data at the end of the top-level operation. Accesses to other
+     * storages are hashed individually, so they go through this storage.
+     */
+    template<typename S = Storage, typename = std::enable_if_t<detail::is_bounds_checked_storage_v<S> || detail::is_contiguous_storage_v<S>>>
+    decltype(auto) unchecked() {
+        if constexpr (detail::is_contiguous_storage_v<Storage>) {
+            // No bytes are accessed, so this just retrieves the unchecked storage
+            memory_storage& base = detail::checked_access(storage, 0);
+            return detail::hashing_memory_view<Hasher> { base, hasher };
+        } else {
+            return (*this);
+        }
+    }
+
+    template<typename S = Storage>
+    auto remaining() const -> decltype(std::declval<const S&>().remaining()) {
+        return storage.remaining();
+    }
+
+    void seek(std::ptrdiff_t num_bytes) {
+        storage.seek(num_bytes);
+    }
+
+    void load(std::byte* target, std::size_t num_bytes) {
+        storage.load(target, num_bytes);
+        hasher.update(target, num_bytes);
+    }
+
+    void store(std::byte* source, std::size_t num_bytes) {
+        hasher.update(source, num_bytes);
+        storage.store(source, num_bytes);
+    }
+
+    /// Checksum over all data loaded or stored since construction or the last reset()
+    typename Hasher::value_type digest() {
+        return hasher.digest();
+    }
+
+    void reset() {
+        hasher.reset();
+    }
+
+    /**
+     * @throws checksum_mismatch_exception if digest() differs from the expected checksum
+     */
+    void verify(typename Hasher::value_type expected) {
+        static_assert(std::is_integral_v<typename Hasher::value_type> && sizeof(typename Hasher::value_type) <= sizeof(std::uint64_t),
+                      "verify() requires integral checksums of at most 64 bits");
+        auto actual = digest();
+        if (actual != expected) {
+            throw checksum_mismatch_exception { expected, actual };
+        }
+    }
+
+    /// Underlying storage
+    Storage& get() {
+        return storage;
+    }
+
+private:
+    Storage& storage;
+    Hasher hasher;
+};
+
+} // namespace blob
+
+#endif // BLOBIFY_HASHING_STORAGE_HPP
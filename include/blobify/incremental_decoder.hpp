@@ -0,0 +1,129 @@
+#ifndef BLOBIFY_INCREMENTAL_DECODER_HPP
+#define BLOBIFY_INCREMENTAL_DECODER_HPP
+
+#include "load.hpp"
+#include "memory_storage.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+
+namespace blob {
+
+/**
+ * Push-based decoder for records of type T that arrive in arbitrarily sized chunks.
+ *
+ * Chunks are passed to feed() as they become available. Records contained in
+ * a chunk entirely are decoded directly from the chunk memory, and only
+ * records spanning multiple chunks are assembled in a small internal buffer.
+ * Bytes are never parsed twice.
+ *
+ *     blob::incremental_decoder<Packet> decoder;
+ *     while (auto chunk = receive()) {
+ *         decoder.feed_all(chunk.data(), chunk.size(), std::back_inserter(packets));
+ *     }
+ *
+ * If decoding a record fails, the exception is propagated from feed() and
+ * the remaining bytes of the offending record (i.e. bytes_needed() before the
+ * call) are considered consumed, so that decoding may continue with the next
+ * record.
+ */
+template<typename T, typename ConstructionPolicy = detail::default_construction_policy>
+class incremental_decoder {
+    static_assert(detail::is_fixed_size<T>(), "incremental_decoder requires records of fixed size");
+
+public:
+    static constexpr std::size_t record_size = detail::total_serialized_size<T>();
+
+    /**
+     * Consumes bytes from the given chunk until a record is complete
+     * @return Number of bytes consumed. This is less than num_bytes if a decoded record is ready
+     */
+    std::size_t feed(const std::byte* data, std::size_t num_bytes) {
+        if (ready()) {
+            return 0;
+        }
+
+        if (fragment_size == 0 && num_bytes >= record_size) {
+            // The entire record is available, so decode it in-place
+            decode(data);
+            return record_size;
+        }
+
+        auto consumed = std::min(num_bytes, bytes_needed());
+        std::memcpy(fragment.data() + fragment_size, data, consumed);
+        fragment_size += consumed;
+        if (fragment_size == record_size) {
+            fragment_size = 0;
+            decode(fragment.data());
+        }
+        return consumed;
+    }
+
+    /**
+     * Decodes all complete records from the given chunk and writes them to
+     * the given output iterator. Trailing bytes are retained for the next call.
+     *
+     * @return Iterator pointing past the last written element
+     * @note If decoding fails, the rest of the chunk is dropped. Use feed() for finer-grained error recovery
+     */
+    template<typename OutputIt>
+    OutputIt feed_all(const std::byte* data, std::size_t num_bytes, OutputIt out) {
+        while (true) {
+            if (ready()) {
+                *out++ = take();
+            }
+            if (num_bytes == 0) {
+                return out;
+            }
+            auto consumed = feed(data, num_bytes);
+            data += consumed;
+            num_bytes -= consumed;
+        }
+    }
+
+    /// Checks if a decoded record can be retrieved with take()
+    bool ready() const {
+        return value.has_value();
+    }
+
+    /// Number of bytes missing to complete the current record (0 if ready)
+    std::size_t bytes_needed() const {
+        return ready() ? 0 : record_size - fragment_size;
+    }
+
+    /**
+     * Returns the decoded record and starts decoding the next one
+     * @pre ready()
+     */
+    T take() {
+        T ret = std::move(*value);
+        value.reset();
+        return ret;
+    }
+
+    /// Drops any partially received record
+    void reset() {
+        fragment_size = 0;
+        value.reset();
+    }
+
+private:
+    void decode(const std::byte* record) {
+        // NOTE: Loads don't modify the underlying memory, so casting away const is fine
+        auto begin = const_cast<std::byte*>(record);
+        value.emplace(load<T>(memory_storage { begin, begin, begin + record_size }, tag<ConstructionPolicy> { }));
+    }
+
+    // Bytes received so far for a record that spans multiple chunks
+    std::array<std::byte, record_size> fragment;
+    std::size_t fragment_size = 0;
+
+    std::optional<T> value;
+};
+
+} // namespace blob
+
+#endif // BLOBIFY_INCREMENTAL_DECODER_HPP
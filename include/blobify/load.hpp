@@ -3,16 +3,23 @@
 
 #include "construction_policy.hpp"
 #include "exceptions.hpp"
+#include "memory_storage.hpp"
 #include "properties.hpp"
 #include "storage_backend.hpp"
 
 #include "detail/is_array.hpp"
+#include "detail/is_vector.hpp"
 
 #include <boost/pfr/core.hpp>
 
 #include <magic_enum.hpp>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <tuple>
+#include <vector>
 
 namespace blob {
 
@@ -42,9 +49,133 @@ constexpr Representative load_element_representative(Storage& storage) {
 template<typename Enum>
 inline constexpr auto magic_enum_values_v = magic_enum::enum_values<Enum>();
 
+/**
+ * Compile-time lookup table for the set of enumerated values of Enum.
+ *
+ * Membership is tested using a bitmap if the enumerated values span a small
+ * range, and using binary search over the sorted values otherwise. Enums with
+ * a contiguous set of values reduce to a bounds check.
+ */
+template<typename Enum>
+struct enum_value_set {
+    using underlying_type = magic_enum::underlying_type_t<Enum>;
+
+    static constexpr auto& values = magic_enum_values_v<Enum>;
+    static constexpr std::size_t num_values = values.size();
+
+    static constexpr underlying_type min_value = [] {
+        underlying_type ret = num_values ? static_cast<underlying_type>(values[0]) : 0;
+        for (auto value : values) {
+            ret = std::min(ret, static_cast<underlying_type>(value));
+        }
+        return ret;
+    }();
+
+    using offset_type = std::make_unsigned_t<underlying_type>;
+
+    // Offset of value from min_value. Computed using modular arithmetic to handle signed types uniformly
+    static constexpr offset_type offset_of(underlying_type value) {
+        return static_cast<offset_type>(static_cast<offset_type>(value) - static_cast<offset_type>(min_value));
+    }
+
+    static constexpr offset_type range = [] {
+        offset_type ret = 0;
+        for (auto value : values) {
+            ret = std::max(ret, offset_of(static_cast<underlying_type>(value)));
+        }
+        return ret;
+    }();
+
+    static constexpr bool is_contiguous = (num_values != 0 && range == num_values - 1);
+    static constexpr bool use_bitmap = (num_values != 0 && range < 4096);
+
+    static constexpr auto bitmap = [] {
+        std::array<std::uint64_t, use_bitmap ? range / 64 + 1 : 1> ret { };
+        if (use_bitmap) {
+            for (auto value : values) {
+                auto offset = offset_of(static_cast<underlying_type>(value));
+                ret[offset / 64] |= std::uint64_t { 1 } << (offset % 64);
+            }
+        }
+        return ret;
+    }();
+
+    static constexpr auto sorted_values = [] {
+        std::array<underlying_type, num_values> ret { };
+        for (std::size_t i = 0; i < num_values; ++i) {
+            // Insertion sort
+            auto value = static_cast<underlying_type>(values[i]);
+            auto j = i;
+            for (; j > 0 && value < ret[j - 1]; --j) {
+                ret[j] = ret[j - 1];
+            }
+            ret[j] = value;
+        }
+        return ret;
+    }();
+
+    /// Checks if value lies within the smallest and the largest enumerated value
+    static constexpr bool in_bounds(Enum value) {
+        return num_values != 0 && offset_of(static_cast<underlying_type>(value)) <= range;
+    }
+
+    /// Checks if value is one of the enumerated values
+    static constexpr bool contains(Enum value) {
+        auto offset = offset_of(static_cast<underlying_type>(value));
+        if constexpr (num_values == 0) {
+            return false;
+        } else if constexpr (is_contiguous) {
+            return offset <= range;
+        } else if constexpr (use_bitmap) {
+            // Clamp the bitmap index rather than branching on the bounds check to allow for vectorization
+            bool in_range = (offset <= range);
+            auto index = in_range ? offset : 0;
+            return in_range & static_cast<bool>((bitmap[index / 64] >> (index % 64)) & 1);
+        } else {
+            std::size_t begin = 0;
+            std::size_t end = num_values;
+            while (begin != end) {
+                auto mid = begin + (end - begin) / 2;
+                if (sorted_values[mid] < static_cast<underlying_type>(value)) {
+                    begin = mid + 1;
+                } else {
+                    end = mid;
+                }
+            }
+            return begin != num_values && sorted_values[begin] == static_cast<underlying_type>(value);
+        }
+    }
+};
+
+/**
+ * Checks if the given value passes all validation checks requested by member_props.
+ * Contrary to validate_element, this does not report the reason of failure.
+ */
+// For std::array members, expected_value refers to the entire array and is hence checked separately in validate_array
+template<auto member_props>
+inline constexpr bool has_element_expected_value =
+        member_props->expected_value && !is_std_array_v<typename std::remove_reference_t<decltype(*member_props)>::value_type>;
+
+template<auto member_props, typename Member>
+constexpr bool is_valid_element(const Member& member) {
+    bool valid = true;
+    if constexpr (has_element_expected_value<member_props>) {
+        valid &= (member == *member_props->expected_value);
+    }
+    if constexpr (member_props->validate_enum) {
+        valid &= enum_value_set<Member>::contains(member);
+    }
+    if constexpr (member_props->validate_enum_bounds) {
+        valid &= enum_value_set<Member>::in_bounds(member);
+    }
+    return valid;
+}
+
 template<auto member_props, typename Member>
 constexpr decltype(auto) validate_element(Member&& member) {
-    if constexpr (member_props->expected_value) {
+    using value_type = std::remove_cv_t<std::remove_reference_t<Member>>;
+
+    if constexpr (has_element_expected_value<member_props>) {
         static_assert(member_props->ptr, "expected_value property is set but the pointer-to-member-data could not be inferred. The pointer must be provided manually in this case.");
 
         if (member != member_props->expected_value) {
@@ -53,28 +184,19 @@ constexpr decltype(auto) validate_element(Member&& member) {
     }
 
     if constexpr (member_props->validate_enum) {
-        static_assert (std::is_enum_v<Member>, "validate_enum property is set on a member that is not an enum");
+        static_assert (std::is_enum_v<value_type>, "validate_enum property is set on a member that is not an enum");
 
-        constexpr auto values = magic_enum::enum_values<Member>();
-        if (std::none_of(values.begin(), values.end(), [=](auto val) { return val == member; })) {
+        if (!enum_value_set<value_type>::contains(member)) {
             throw invalid_enum_value_exception_for<member_props->ptr>(member);
         }
     }
 
     if constexpr (member_props->validate_enum_bounds) {
-        static_assert (std::is_enum_v<Member>, "validate_enum_bounds property is set on a member that is not an enum");
+        static_assert (std::is_enum_v<value_type>, "validate_enum_bounds property is set on a member that is not an enum");
         static_assert (!member_props->validate_enum, "Setting validate_enum_bounds when validate_enum is already set is redundant");
 
-        auto enum_less = [](auto left, auto right) {
-            using type = magic_enum::underlying_type_t<Member>;
-            return (static_cast<type>(left) < static_cast<type>(right));
-        };
-        constexpr auto values_begin = magic_enum_values_v<Member>.begin();
-        constexpr auto values_end = magic_enum_values_v<Member>.end();
-        constexpr auto minmax_value = std::minmax_element(values_begin, values_end, enum_less);
-
         // NOTE: The bounds are computed at compile-time
-        if (enum_less(member, *minmax_value.first) || enum_less(*minmax_value.second, member)) {
+        if (!enum_value_set<value_type>::in_bounds(member)) {
             throw invalid_enum_value_exception_for<member_props->ptr>(member);
         }
     }
@@ -82,25 +204,136 @@ constexpr decltype(auto) validate_element(Member&& member) {
     return std::forward<Member>(member);
 }
 
+/// validate_element, unless ConstructionPolicy loads data that has been validated before
+template<auto member_props, typename ConstructionPolicy, typename Member>
+constexpr decltype(auto) validate_loaded_element(Member&& member) {
+    if constexpr (policy_traits<ConstructionPolicy>::validates) {
+        return validate_element<member_props>(std::forward<Member>(member));
+    } else {
+        return std::forward<Member>(member);
+    }
+}
+
+/// Checks the expected_value property of std::array members
+template<auto member_props, typename ArrayType>
+constexpr void validate_array(const ArrayType& array) {
+    if constexpr (member_props->expected_value) {
+        static_assert(member_props->ptr, "expected_value property is set but the pointer-to-member-data could not be inferred. The pointer must be provided manually in this case.");
+
+        if (array != *member_props->expected_value) {
+            throw unexpected_value_exception<member_props->ptr>(*member_props->expected_value, array);
+        }
+    }
+}
+
+/**
+ * Validates a block of elements. All elements are checked without early exit
+ * so that the compiler can vectorize the loop. The offending element is only
+ * searched for if the block turns out to be invalid.
+ */
+template<auto member_props, typename ElementType>
+void validate_elements(const ElementType* elements, std::size_t count) {
+    // NOTE: Accumulating in an integer of the element size rather than in a bool helps vectorization
+    std::make_unsigned_t<decltype(select_representative<ElementType>())> invalid = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        invalid |= !is_valid_element<member_props>(elements[i]);
+    }
+
+    if (invalid) {
+        for (std::size_t i = 0; i < count; ++i) {
+            validate_element<member_props>(elements[i]);
+        }
+    }
+}
+
 template<typename ElementType, auto member_props, typename Storage, typename ConstructionPolicy, std::size_t NumElements>
 constexpr std::array<ElementType, NumElements>
 load_array(Storage& storage);
 
+template<typename Member, auto member_props, typename Storage, typename ConstructionPolicy>
+constexpr void load_element_into(Storage& storage, Member& target);
+
+/**
+ * Load count elementary values with a single storage access, then convert
+ * them from their serialized endianness and validate them in separate passes
+ */
+template<auto member_props, typename ConstructionPolicy, typename Storage, typename ElementType>
+void load_elements_bulk(Storage& storage, ElementType* elements, std::size_t count) {
+    transfer_in_chunks(storage, sizeof(ElementType), count, [&](std::size_t first, std::size_t num_elements) {
+        storage.load(reinterpret_cast<std::byte*>(elements + first), num_elements * sizeof(ElementType));
+        if constexpr (member_props->endianness != endian::native) {
+            byteswap_n(elements + first, num_elements);
+        }
+        if constexpr (policy_traits<ConstructionPolicy>::validates &&
+                      (has_element_expected_value<member_props> || member_props->validate_enum || member_props->validate_enum_bounds)) {
+            validate_elements<member_props>(elements + first, num_elements);
+        }
+    });
+}
+
 // Load a single element (possibly aggregate)
 template<typename Member, auto member_props, typename Storage, typename ConstructionPolicy>
 constexpr Member load_element(Storage& storage) {
+    static_assert(!is_variable_length_v<Member>, "Variable-length elements may only be loaded as members of an aggregate with a count member");
+
     if constexpr (detail::is_std_array_v<Member>) {
         // Optimized code path for collections of uniform type
-        return load_array<typename Member::value_type, member_props, Storage, ConstructionPolicy, std::tuple_size_v<Member>>(storage);
+        auto array = load_array<typename Member::value_type, member_props, Storage, ConstructionPolicy, std::tuple_size_v<Member>>(storage);
+        if constexpr (policy_traits<ConstructionPolicy>::validates) {
+            validate_array<member_props>(array);
+        }
+        return array;
     } else if constexpr (std::is_class_v<Member>) {
         return do_load<Member, Storage&, ConstructionPolicy>(storage, {});
     } else {
         using representative_type = typename std::remove_reference_t<decltype(*member_props)>::representative_type;
         auto representative = load_element_representative<representative_type>(storage);
-        return validate_element<member_props>(ConstructionPolicy::template decode<Member, representative_type, member_props->endianness>(representative));
+        return validate_loaded_element<member_props, ConstructionPolicy>(ConstructionPolicy::template decode<Member, representative_type, member_props->endianness>(representative));
     }
 }
 
+/// Reads the word holding the bit-field member at Idx of Data and converts it to native endianness
+template<typename Data, std::size_t Idx, typename Storage>
+constexpr auto load_bit_field_word(Storage& storage) {
+    constexpr auto& layout = layout_for<Data>.members[Idx];
+    auto word = load_element_representative<bit_field_word_t<layout.word_size>>(storage);
+    if constexpr (layout.endianness != endian::native) {
+        word = byteswap(word);
+    }
+    return word;
+}
+
+/**
+ * Decodes the bit-field member at Idx of Data from its (native-endian) word.
+ * The result is not validated.
+ */
+template<typename Data, std::size_t Idx, typename ConstructionPolicy, typename Word>
+constexpr auto extract_bit_field(Word word) {
+    using Member = boost::pfr::tuple_element_t<Idx, Data>;
+    using representative_type = typename std::remove_reference_t<decltype(member_properties_for<Data, Idx>)>::representative_type;
+    using unsigned_type = std::make_unsigned_t<representative_type>;
+    constexpr auto& layout = layout_for<Data>.members[Idx];
+    constexpr auto mask = (layout.bit_width == 8 * sizeof(Word)) ? static_cast<Word>(~Word { 0 }) : static_cast<Word>((Word { 1 } << layout.bit_width) - 1);
+
+    auto bits = static_cast<unsigned_type>((word >> layout.bit_offset) & mask);
+    if constexpr (std::is_signed_v<representative_type> && layout.bit_width < 8 * sizeof(representative_type)) {
+        // Sign-extend
+        constexpr auto sign_bit = static_cast<unsigned_type>(unsigned_type { 1 } << (layout.bit_width - 1));
+        bits = static_cast<unsigned_type>((bits ^ sign_bit) - sign_bit);
+    }
+    return ConstructionPolicy::template decode<Member, representative_type, endian::native>(static_cast<representative_type>(bits));
+}
+
+/// Load all bit-field members sharing the word of the member at FirstIdx with a single storage access
+template<typename Data, std::size_t FirstIdx, typename Storage, typename ConstructionPolicy, typename AssignField>
+constexpr void load_bit_field_word_into(Storage& storage, AssignField&& assign) {
+    auto word = load_bit_field_word<Data, FirstIdx>(storage);
+    for_each_bit_field_in_word<Data, FirstIdx>([&](auto field_index) {
+        constexpr std::size_t Idx = decltype(field_index)::value;
+        assign(field_index, validate_loaded_element<&member_properties_for<Data, Idx>, ConstructionPolicy>(extract_bit_field<Data, Idx, ConstructionPolicy>(word)));
+    });
+}
+
 template<typename ElementType, auto member_props, typename Storage, typename ConstructionPolicy, std::size_t... Idxs>
 constexpr auto load_array_elementwise(Storage& storage, std::index_sequence<Idxs...>) {
     constexpr auto num_elements = sizeof...(Idxs);
@@ -112,13 +345,23 @@ template<typename ElementType, auto member_props, typename Storage, typename Con
 constexpr std::array<ElementType, NumElements>
 load_array(Storage& storage) {
     using ArrayType = std::array<ElementType, NumElements>;
-    if constexpr (NumElements > 8 && std::is_default_constructible_v<ElementType>) {
+    if constexpr (can_bulk_transfer_v<ConstructionPolicy, ArrayType, member_props>) {
+        // Serialized layout matches the in-memory layout, so load all elements at once
+        ArrayType array;
+        storage.load(reinterpret_cast<std::byte*>(array.data()), sizeof(array));
+        return array;
+    } else if constexpr (can_bulk_decode_v<ConstructionPolicy, ElementType>) {
+        ArrayType array;
+        load_elements_bulk<member_props, ConstructionPolicy>(storage, array.data(), NumElements);
+        return array;
+    } else if constexpr (NumElements > 8 && std::is_default_constructible_v<ElementType>) {
         // For a large-ish array, prefer allocating it on stack and
         // initializing it using a loop, since doing so is much easier
-        // on the compiler
-        ArrayType array { };
+        // on the compiler. Elements are loaded in place, so there is no
+        // need to value-initialize the array first
+        ArrayType array;
         for (auto& element : array) {
-            element = load_element<ElementType, member_props, Storage, ConstructionPolicy>(storage);
+            load_element_into<ElementType, member_props, Storage, ConstructionPolicy>(storage, element);
         }
         return array;
     } else {
@@ -137,15 +380,191 @@ struct load_helper_t<Storage, ConstructionPolicy, Data, std::tuple<Members...>>
     }
 };
 
+template<typename Data, typename Storage, typename ConstructionPolicy>
+constexpr void do_load_into(Storage& storage, Data& data);
+
 template<typename Data,
          typename Storage,
          typename ConstructionPolicy>
 constexpr Data do_load(Storage& storage, tag<ConstructionPolicy>) {
     detail::generic_validate<Data>();
 
-    using members_tuple_t = decltype(boost::pfr::structure_to_tuple(std::declval<Data>()));
-    constexpr auto index_sequence = std::make_index_sequence<std::tuple_size_v<members_tuple_t>> { };
-    return detail::load_helper_t<Storage, ConstructionPolicy, Data, members_tuple_t>{}(storage, index_sequence);
+    if constexpr (can_bulk_transfer_v<ConstructionPolicy, Data, &properties_for<Data>>) {
+        // Serialized layout matches the in-memory layout, so load the entire aggregate at once
+        Data data;
+        storage.load(reinterpret_cast<std::byte*>(&data), sizeof(data));
+        return data;
+    } else if constexpr (!is_fixed_size<Data>() || layout_for<Data>.has_bit_fields) {
+        // Variable-length members depend on previously loaded count members,
+        // and bit-field members are loaded word by word, so assign the members in order
+        Data data { };
+        do_load_into<Data, Storage, ConstructionPolicy>(storage, data);
+        return data;
+    } else {
+        using members_tuple_t = decltype(boost::pfr::structure_to_tuple(std::declval<Data>()));
+        constexpr auto index_sequence = std::make_index_sequence<std::tuple_size_v<members_tuple_t>> { };
+        return detail::load_helper_t<Storage, ConstructionPolicy, Data, members_tuple_t>{}(storage, index_sequence);
+    }
+}
+
+/**
+ * Load count elements into the given memory range, using a single storage
+ * access where possible
+ */
+template<auto member_props, typename Storage, typename ConstructionPolicy, typename ElementType>
+constexpr void load_elements_into(Storage& storage, ElementType* elements, std::size_t count) {
+    if constexpr (can_bulk_transfer_v<ConstructionPolicy, ElementType, member_props>) {
+        // Serialized layout matches the in-memory layout, so load all elements at once
+        transfer_in_chunks(storage, sizeof(ElementType), count, [&](std::size_t first, std::size_t num_elements) {
+            storage.load(reinterpret_cast<std::byte*>(elements + first), num_elements * sizeof(ElementType));
+        });
+    } else if constexpr (can_bulk_decode_v<ConstructionPolicy, ElementType>) {
+        load_elements_bulk<member_props, ConstructionPolicy>(storage, elements, count);
+    } else {
+        access_in_chunks(storage, sizeof(ElementType), count, [&](std::size_t i) {
+            load_element_into<ElementType, member_props, Storage, ConstructionPolicy>(storage, elements[i]);
+        });
+    }
+}
+
+/// Reads the number of elements of a variable-length member from its (previously loaded) count member
+template<std::size_t CountIdx, typename Data>
+std::size_t load_element_count(const Data& data) {
+    auto count = boost::pfr::get<CountIdx>(data);
+    if constexpr (std::is_signed_v<decltype(count)>) {
+        if (count < 0) {
+            throw invalid_length_exception { static_cast<std::size_t>(count) };
+        }
+    }
+    return static_cast<std::size_t>(count);
+}
+
+/**
+ * Load count elements into the given variable-length member. Views refer to
+ * the storage memory directly rather than copying the elements.
+ */
+template<auto member_props, typename Storage, typename ConstructionPolicy, typename Member>
+void load_variable_length(Storage& storage, Member& target, std::size_t count) {
+    using ElementType = array_element_t<Member>;
+    auto&& source = checked_access(storage, total_serialized_size<ElementType>(), count);
+    using SourceStorage = std::remove_reference_t<decltype(source)>;
+
+    // Whether the storage has been checked to hold count elements (or can't be checked at all)
+    constexpr bool count_known_valid = is_bounds_checked_storage_v<Storage> || std::is_same_v<Storage, memory_storage>;
+    constexpr std::size_t max_unchecked_elements = std::max<std::size_t>(64 * 1024 / sizeof(ElementType), 1);
+
+    if constexpr (is_variable_length_view_v<Member>) {
+        static_assert(std::is_base_of_v<memory_storage, SourceStorage>, "View members require a contiguous storage");
+        static_assert(can_bulk_transfer_v<ConstructionPolicy, ElementType, member_props>,
+                      "View members require elements with identical serialized and in-memory representation");
+        if (reinterpret_cast<std::uintptr_t>(source.current) % alignof(ElementType) != 0) {
+            throw misaligned_view_exception { };
+        }
+        target = Member { reinterpret_cast<typename Member::pointer>(source.current), count };
+        source.current += count * sizeof(ElementType);
+    } else if constexpr (std::is_same_v<ElementType, bool>) {
+        // std::vector<bool> doesn't provide access to its elements in memory
+        target.clear();
+        target.reserve(count_known_valid ? count : std::min(count, max_unchecked_elements));
+        for (std::size_t i = 0; i < count; ++i) {
+            target.push_back(load_element<bool, member_props, SourceStorage, ConstructionPolicy>(source));
+        }
+    } else if constexpr (count_known_valid) {
+        target.resize(count);
+        load_elements_into<member_props, SourceStorage, ConstructionPolicy>(source, target.data(), count);
+    } else {
+        // The count hasn't been checked against the available data, so grow the
+        // container while loading rather than allocating memory for corrupt counts up-front
+        target.clear();
+        for (std::size_t first = 0; first < count; first += max_unchecked_elements) {
+            auto block_count = std::min(count - first, max_unchecked_elements);
+            target.resize(first + block_count);
+            load_elements_into<member_props, SourceStorage, ConstructionPolicy>(source, target.data() + first, block_count);
+        }
+    }
+}
+
+template<typename Storage, typename ConstructionPolicy, typename Data, std::size_t... Idxs>
+constexpr void load_members_into(Storage& storage, Data& data, std::index_sequence<Idxs...>) {
+    auto load_member = [&](auto index_constant) {
+        constexpr std::size_t Idx = decltype(index_constant)::value;
+        using Member = boost::pfr::tuple_element_t<Idx, Data>;
+        constexpr auto member_props = &member_properties_for<Data, Idx>;
+        constexpr auto& layout = layout_for<Data>.members[Idx];
+        if constexpr (layout.kind == member_kind::variable_length) {
+            auto count = load_element_count<layout.count_member_index>(data);
+            load_variable_length<member_props, Storage, ConstructionPolicy>(storage, boost::pfr::get<Idx>(data), count);
+        } else if constexpr (layout.kind == member_kind::bit_field) {
+            // All bit-fields of a word are loaded along with the first one
+            if constexpr (layout.bit_offset == 0) {
+                load_bit_field_word_into<Data, Idx, Storage, ConstructionPolicy>(storage, [&](auto field_index, auto value) {
+                    boost::pfr::get<decltype(field_index)::value>(data) = value;
+                });
+            }
+        } else {
+            load_element_into<Member, member_props, Storage, ConstructionPolicy>(storage, boost::pfr::get<Idx>(data));
+        }
+    };
+    (load_member(std::integral_constant<std::size_t, Idxs> { }), ...);
+}
+
+/**
+ * do_load variant that assigns the loaded members to an existing object
+ */
+template<typename Data, typename Storage, typename ConstructionPolicy>
+constexpr void do_load_into(Storage& storage, Data& data) {
+    detail::generic_validate<Data>();
+
+    if constexpr (can_bulk_transfer_v<ConstructionPolicy, Data, &properties_for<Data>>) {
+        storage.load(reinterpret_cast<std::byte*>(&data), sizeof(data));
+    } else {
+        constexpr auto index_sequence = std::make_index_sequence<boost::pfr::tuple_size_v<Data>> { };
+        load_members_into<Storage, ConstructionPolicy>(storage, data, index_sequence);
+    }
+}
+
+// Load a single element (possibly aggregate) into an existing object
+template<typename Member, auto member_props, typename Storage, typename ConstructionPolicy>
+constexpr void load_element_into(Storage& storage, Member& target) {
+    if constexpr (detail::is_std_array_v<Member>) {
+        load_elements_into<member_props, Storage, ConstructionPolicy>(storage, target.data(), target.size());
+        if constexpr (policy_traits<ConstructionPolicy>::validates) {
+            validate_array<member_props>(target);
+        }
+    } else if constexpr (std::is_class_v<Member>) {
+        do_load_into<Member, Storage, ConstructionPolicy>(storage, target);
+    } else {
+        target = load_element<Member, member_props, Storage, ConstructionPolicy>(storage);
+    }
+}
+
+template<typename Data, std::size_t... Idxs>
+auto make_soa_columns(std::index_sequence<Idxs...>) -> std::tuple<std::vector<boost::pfr::tuple_element_t<Idxs, Data>>...>;
+
+/**
+ * Load the members of a single record into the given row of the member columns
+ */
+template<typename Data, typename Storage, typename ConstructionPolicy, typename Columns, std::size_t... Idxs>
+constexpr void load_soa_row(Storage& storage, Columns& columns, std::size_t row, std::index_sequence<Idxs...>) {
+    auto load_member = [&](auto index_constant) {
+        constexpr std::size_t Idx = decltype(index_constant)::value;
+        using Member = boost::pfr::tuple_element_t<Idx, Data>;
+        constexpr auto member_props = &member_properties_for<Data, Idx>;
+        constexpr auto& layout = layout_for<Data>.members[Idx];
+        if constexpr (layout.kind == member_kind::bit_field) {
+            if constexpr (layout.bit_offset == 0) {
+                load_bit_field_word_into<Data, Idx, Storage, ConstructionPolicy>(storage, [&](auto field_index, auto value) {
+                    std::get<decltype(field_index)::value>(columns)[row] = value;
+                });
+            }
+        } else if constexpr (layout.kind == member_kind::boolean) {
+            // std::vector<bool> doesn't provide references to its elements
+            std::get<Idx>(columns)[row] = load_element<Member, member_props, Storage, ConstructionPolicy>(storage);
+        } else {
+            load_element_into<Member, member_props, Storage, ConstructionPolicy>(storage, std::get<Idx>(columns)[row]);
+        }
+    };
+    (load_member(std::integral_constant<std::size_t, Idxs> { }), ...);
 }
 
 /**
@@ -170,6 +589,8 @@ constexpr auto lens_load_from_offset(Storage& storage, std::size_t offset,
     } else {
         // This is the actual object requested by the user, so use the standard load_element code path to fetch it
         using MemberType = std::remove_reference_t<decltype(std::declval<Data>().*PointerToMember1)>;
+        constexpr bool is_bit_field = is_bit_field_member<Data, member_index>();
+        constexpr auto member_size = is_bit_field ? layout_for<Data>.members[member_index].word_size : total_serialized_size<MemberType>();
 
         // Local helper struct to seek to the member and back upon return.
         struct StorageSeeker {
@@ -183,19 +604,64 @@ constexpr auto lens_load_from_offset(Storage& storage, std::size_t offset,
 
             ~StorageSeeker() {
                 // Move back to the beginning of the parent aggregate
-                storage.seek(-static_cast<std::ptrdiff_t>(offset + total_serialized_size<MemberType>()));
+                storage.seek(-static_cast<std::ptrdiff_t>(offset + member_size));
             }
         } seeker(storage, offset);
 
         constexpr auto& member_properties = detail::member_properties_for<Data, member_index>;
-        return detail::load_element<MemberType, &member_properties, Storage, ConstructionPolicy>(storage);
+        if constexpr (is_bit_field) {
+            auto word = load_bit_field_word<Data, member_index>(storage);
+            return validate_loaded_element<&member_properties, ConstructionPolicy>(extract_bit_field<Data, member_index, ConstructionPolicy>(word));
+        } else {
+            return detail::load_element<MemberType, &member_properties, Storage, ConstructionPolicy>(storage);
+        }
     }
 }
 
+/**
+ * Loads the members at the given positions of the sorted access order of a
+ * lens_batch into the corresponding tuple elements of values
+ */
+template<typename Data, typename ConstructionPolicy, typename Batch, typename Storage, typename Values, std::size_t... Positions>
+void lens_load_batch(Storage& storage, Values& values, std::index_sequence<Positions...>) {
+    lens_rewinder<Storage> rewinder { storage };
+
+    // Most recently loaded bit-field word
+    [[maybe_unused]] std::uint64_t word = 0;
+
+    auto load_access = [&](auto position) {
+        constexpr std::size_t Pos = decltype(position)::value;
+        constexpr std::size_t Access = Batch::order[Pos];
+        constexpr std::size_t Idx = Batch::member_indices[Access];
+        using MemberType = std::tuple_element_t<Access, Values>;
+        constexpr auto& member_properties = member_properties_for<Data, Idx>;
+
+        if constexpr (!Batch::shares_previous_word(Pos)) {
+            constexpr auto skipped_bytes = Batch::offsets[Access] - Batch::end_before(Pos);
+            if constexpr (skipped_bytes != 0) {
+                storage.seek(skipped_bytes);
+            }
+            rewinder.position = Batch::offsets[Access] + Batch::sizes[Access];
+        }
+
+        if constexpr (is_bit_field_member<Data, Idx>()) {
+            using Word = bit_field_word_t<layout_for<Data>.members[Idx].word_size>;
+            if constexpr (!Batch::shares_previous_word(Pos)) {
+                word = load_bit_field_word<Data, Idx>(storage);
+            }
+            std::get<Access>(values) = validate_loaded_element<&member_properties, ConstructionPolicy>(extract_bit_field<Data, Idx, ConstructionPolicy>(static_cast<Word>(word)));
+        } else {
+            std::get<Access>(values) = load_element<MemberType, &member_properties, Storage, ConstructionPolicy>(storage);
+        }
+    };
+    (load_access(std::integral_constant<std::size_t, Positions> { }), ...);
+}
+
 } // namespace detail
 
 /**
  * @post Advances the input stream by the serialized size of Data
+ * @note For bounds-checked storages, the bounds are checked once for the entire object before loading any data
  */
 template<typename Data,
          typename Storage = detail::default_storage_backend,
@@ -203,8 +669,9 @@ template<typename Data,
 constexpr Data load(Storage&& storage, tag<ConstructionPolicy> = { }) {
     static_assert(detail::has_deducible_properties<Data>, "Data properties are not implicitly deducible");
     if constexpr (detail::has_deducible_properties<Data>) {
-        using StorageType = std::remove_reference_t<Storage>;
-        return detail::do_load<Data, StorageType, ConstructionPolicy>(storage, {});
+        auto&& source = detail::checked_access_for<Data>(storage);
+        using StorageType = std::remove_reference_t<decltype(source)>;
+        return detail::do_load<Data, StorageType, ConstructionPolicy>(source, {});
     }
 }
 
@@ -218,11 +685,21 @@ template<typename ContainerData,
          typename Storage,
          typename ConstructionPolicy = detail::default_construction_policy>
 constexpr ContainerData load_many_explicit(Storage&& storage, std::size_t count, tag<ConstructionPolicy> = {}) {
+    using Data = typename ContainerData::value_type;
+    auto&& source = detail::checked_access_for<Data>(storage, count);
+    using StorageType = std::remove_reference_t<decltype(source)>;
     ContainerData container;
-    container.reserve(count);
 
-    for (std::size_t i = 0; i < count; ++i) {
-        container.push_back(detail::load_element<typename ContainerData::value_type, Properties, std::remove_reference_t<Storage>, ConstructionPolicy>(storage));
+    if constexpr (detail::is_std_vector_v<ContainerData> && std::is_default_constructible_v<Data>) {
+        // Load elements directly into the final container memory
+        container.resize(count);
+        detail::load_elements_into<Properties, StorageType, ConstructionPolicy>(source, container.data(), count);
+    } else {
+        container.reserve(count);
+
+        detail::access_in_chunks(source, detail::total_serialized_size<Data>(), count, [&](std::size_t) {
+            container.push_back(detail::load_element<Data, Properties, StorageType, ConstructionPolicy>(source));
+        });
     }
     return container;
 }
@@ -241,6 +718,108 @@ constexpr ContainerData load_many(Storage&& storage, std::size_t count, tag<Cons
     }
 }
 
+/**
+ * Variant of load() that decodes into an existing object rather than
+ * returning a new one. Members are assigned in place, so no temporaries are
+ * created for large std::array members.
+ *
+ * @post Advances the input stream by the serialized size of Data
+ * @note If an exception is thrown, data may have been partially overwritten
+ */
+template<typename Data,
+         typename Storage,
+         typename ConstructionPolicy = detail::default_construction_policy>
+constexpr void load_into(Storage&& storage, Data& data, tag<ConstructionPolicy> = { }) {
+    static_assert(detail::has_deducible_properties<Data>, "Data properties are not implicitly deducible");
+    if constexpr (detail::has_deducible_properties<Data>) {
+        auto&& source = detail::checked_access_for<Data>(storage);
+        using StorageType = std::remove_reference_t<decltype(source)>;
+        detail::do_load_into<Data, StorageType, ConstructionPolicy>(source, data);
+    }
+}
+
+/**
+ * Variant of load_many_into with explicitly provided properties. Use this for
+ * loading collections of elementary types, for which properties() generally
+ * is not implemented.
+ */
+template<auto Properties,
+         typename Storage,
+         typename Range,
+         typename ConstructionPolicy = detail::default_construction_policy>
+constexpr void load_many_explicit_into(Storage&& storage, Range&& range, tag<ConstructionPolicy> = {}) {
+    using Data = std::remove_reference_t<decltype(*std::data(range))>;
+    auto&& source = detail::checked_access_for<Data>(storage, std::size(range));
+    using StorageType = std::remove_reference_t<decltype(source)>;
+    detail::load_elements_into<Properties, StorageType, ConstructionPolicy>(source, std::data(range), std::size(range));
+}
+
+/**
+ * Loads one element for each entry of the given contiguous range (e.g.
+ * std::vector, std::array, or std::span) directly into the range memory.
+ */
+template<typename Storage,
+         typename Range,
+         typename ConstructionPolicy = detail::default_construction_policy>
+constexpr void load_many_into(Storage&& storage, Range&& range, tag<ConstructionPolicy> tag = {}) {
+    using Data = std::remove_reference_t<decltype(*std::data(range))>;
+    static_assert(detail::has_deducible_properties<Data>, "Data properties are not implicitly deducible. Use load_many_explicit_into instead");
+    if constexpr (detail::has_deducible_properties<Data>) {
+        constexpr auto Properties = &detail::properties_for<Data>;
+        load_many_explicit_into<Properties>(storage, range, tag);
+    }
+}
+
+/**
+ * Loads count elements and writes them to the given output iterator
+ * @return Iterator pointing past the last written element
+ */
+template<typename Data,
+         typename Storage,
+         typename OutputIt,
+         typename ConstructionPolicy = detail::default_construction_policy>
+constexpr OutputIt load_many_into(Storage&& storage, std::size_t count, OutputIt out, tag<ConstructionPolicy> = {}) {
+    static_assert(detail::has_deducible_properties<Data>, "Data properties are not implicitly deducible");
+    auto&& source = detail::checked_access_for<Data>(storage, count);
+    using StorageType = std::remove_reference_t<decltype(source)>;
+    for (std::size_t i = 0; i < count; ++i) {
+        *out++ = detail::load_element<Data, &detail::properties_for<Data>, StorageType, ConstructionPolicy>(source);
+    }
+    return out;
+}
+
+/// Tuple of one std::vector per member of Data, as returned by load_many_soa
+template<typename Data>
+using soa_columns_t = decltype(detail::make_soa_columns<Data>(std::make_index_sequence<boost::pfr::tuple_size_v<Data>> { }));
+
+/**
+ * Variant of load_many that returns the loaded records in struct-of-arrays
+ * form, i.e. as one std::vector per member of Data (in declaration order).
+ * Records are decoded in a single pass over the input, with each member
+ * written directly to its column.
+ *
+ * @post Advances the input stream by count times the serialized size of Data
+ */
+template<typename Data,
+         typename Storage,
+         typename ConstructionPolicy = detail::default_construction_policy>
+soa_columns_t<Data> load_many_soa(Storage&& storage, std::size_t count, tag<ConstructionPolicy> = {}) {
+    static_assert(detail::has_deducible_properties<Data>, "Data properties are not implicitly deducible");
+    static_assert(detail::is_fixed_size<Data>(), "load_many_soa does not support variable-length members");
+    detail::generic_validate<Data>();
+
+    auto&& source = detail::checked_access(storage, detail::total_serialized_size<Data>(), count);
+    using StorageType = std::remove_reference_t<decltype(source)>;
+
+    constexpr auto index_sequence = std::make_index_sequence<boost::pfr::tuple_size_v<Data>> { };
+    soa_columns_t<Data> columns;
+    std::apply([count](auto&... column) { (column.resize(count), ...); }, columns);
+    for (std::size_t row = 0; row < count; ++row) {
+        detail::load_soa_row<Data, StorageType, ConstructionPolicy>(source, columns, row, index_sequence);
+    }
+    return columns;
+}
+
 /**
  * Loads a single (possibly deeply nested) struct member from the input storage.
  * The member is assumed to be contained in a serialized blob of the parent of
@@ -267,8 +846,42 @@ constexpr auto lens_load(Storage&& storage,
     detail::generic_validate<Data>();
     static_assert(detail::is_valid_pmd_chain_v<Data, decltype(PointerToMember1), decltype(PointersToMember)...>,
                   "Given list of pointers-to-member does not form a valid member lookup chain");
+    static_assert(detail::is_fixed_size<Data>(), "Member offsets of aggregates with variable-length members are not known statically");
 
-    return detail::lens_load_from_offset<std::remove_reference_t<Storage>, ConstructionPolicy, PointerToMember1, PointersToMember...>(storage, 0);
+    auto&& source = detail::checked_access(storage, detail::total_serialized_size<Data>());
+    return detail::lens_load_from_offset<std::remove_reference_t<decltype(source)>, ConstructionPolicy, PointerToMember1, PointersToMember...>(source, 0);
+}
+
+/**
+ * Loads several direct members of the parent of PointerToMember1 from the
+ * input storage, like a sequence of lens_load calls.
+ *
+ * The members are loaded in the order of their serialized offsets within a
+ * single forward pass, after which the storage is moved back to the beginning
+ * of the blob. This avoids seeking back and forth for each member.
+ *
+ * @return Tuple of the loaded members, in the order of the given pointers-to-member
+ */
+template<auto PointerToMember1,
+         auto... PointersToMember,
+         typename Storage,
+         typename ConstructionPolicy = detail::default_construction_policy
+         >
+auto lens_load_many(Storage&& storage, tag<ConstructionPolicy> = { }) {
+    using Data = typename detail::pmd_traits_t<PointerToMember1>::parent_type;
+    detail::generic_validate<Data>();
+    static_assert((std::is_same_v<typename detail::pmd_traits_t<PointersToMember>::parent_type, Data> && ...),
+                  "All pointers-to-member must refer to members of the same aggregate");
+    static_assert(detail::is_fixed_size<Data>(), "Member offsets of aggregates with variable-length members are not known statically");
+
+    using Batch = detail::lens_batch<Data, PointerToMember1, PointersToMember...>;
+    static_assert(Batch::is_disjoint(), "Members may not be loaded more than once");
+
+    auto&& source = detail::checked_access(storage, detail::total_serialized_size<Data>());
+    std::tuple<typename detail::pmd_traits_t<PointerToMember1>::member_type,
+               typename detail::pmd_traits_t<PointersToMember>::member_type...> values;
+    detail::lens_load_batch<Data, ConstructionPolicy, Batch>(source, values, std::make_index_sequence<Batch::size> { });
+    return values;
 }
 
 } // namespace blob
@@ -1,6 +1,8 @@
 #ifndef BLOBIFY_MEMORY_STORAGE_HPP
 #define BLOBIFY_MEMORY_STORAGE_HPP
 
+#include "exceptions.hpp"
+
 #include <cstddef>
 #include <cstring>
 #include <iterator>
@@ -22,6 +24,11 @@ struct memory_storage {
                                 reinterpret_cast<std::byte*>(std::end(array)) };
     }
 
+    /// Number of bytes between the cursor and the end of the buffer
+    std::size_t remaining() const {
+        return static_cast<std::size_t>(buffer_end - current);
+    }
+
     void seek(std::ptrdiff_t size) {
         current += size;
     }
@@ -37,6 +44,50 @@ struct memory_storage {
     }
 };
 
+/**
+ * Variant of memory_storage that checks all accesses against the buffer bounds.
+ *
+ * Top-level operations such as load() and load_many() check the total
+ * serialized size once up-front and then perform the individual member
+ * accesses through the unchecked base storage.
+ */
+struct checked_memory_storage : memory_storage {
+    template<typename T, size_t N>
+    static constexpr checked_memory_storage OnArray(T (&array)[N]) {
+        return checked_memory_storage { memory_storage::OnArray(array) };
+    }
+
+    /**
+     * @throws storage_exhausted_exception if fewer than num_bytes bytes are left in the buffer
+     */
+    void require(std::size_t num_bytes) const {
+        if (num_bytes > remaining()) {
+            throw storage_exhausted_exception { };
+        }
+    }
+
+    memory_storage& unchecked() {
+        return *this;
+    }
+
+    void seek(std::ptrdiff_t size) {
+        if (size < buffer_begin - current || size > buffer_end - current) {
+            throw storage_exhausted_exception { };
+        }
+        memory_storage::seek(size);
+    }
+
+    void load(std::byte* buffer, size_t size) {
+        require(size);
+        memory_storage::load(buffer, size);
+    }
+
+    void store(std::byte* buffer, size_t size) {
+        require(size);
+        memory_storage::store(buffer, size);
+    }
+};
+
 } // namespace blob
 
 #endif // BLOBIFY_MEMORY_STORAGE_HPP
@@ -0,0 +1,260 @@
+#ifndef BLOBIFY_MMAP_STORAGE_HPP
+#define BLOBIFY_MMAP_STORAGE_HPP
+
+#if defined(_WIN32)
+#error "mmap_storage is only available on POSIX platforms"
+#endif
+
+#include "exceptions.hpp"
+#include "memory_storage.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace blob {
+
+/**
+ * Storage backend operating on a memory-mapped file.
+ *
+ * Data is accessed through the page cache directly, so only the pages touched
+ * by a load/store are read from disk. This is particularly useful for random
+ * access patterns such as lens_load/lens_modify on large files.
+ *
+ * Accesses beyond the end of the mapping throw storage_exhausted_exception.
+ * Like checked_memory_storage, this is checked once per top-level operation.
+ * Stores to read_only mappings throw storage_io_exception. Writable mappings
+ * can be grown (or shrunk) using resize().
+ */
+class mmap_storage {
+public:
+    enum class mode {
+        read_only,
+        read_write
+    };
+
+    /// Access pattern hints forwarded to madvise
+    enum class access_hint {
+        normal,
+        sequential,
+        random,
+        willneed
+    };
+
+    /**
+     * Maps the file at the given path. In read_write mode, the file is created if it doesn't exist
+     * @throws storage_io_exception if the file could not be opened or mapped
+     */
+    explicit mmap_storage(const char* path, mode access_mode = mode::read_only)
+        : access_mode(access_mode) {
+        fd = ::open(path, access_mode == mode::read_write ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+        if (fd < 0) {
+            throw storage_io_exception { errno };
+        }
+
+        struct stat file_stat;
+        if (::fstat(fd, &file_stat) != 0) {
+            auto error = errno;
+            ::close(fd);
+            throw storage_io_exception { error };
+        }
+
+        try {
+            map(static_cast<std::size_t>(file_stat.st_size));
+        } catch (storage_io_exception&) {
+            ::close(fd);
+            throw;
+        }
+        region.current = region.buffer_begin;
+    }
+
+    mmap_storage(mmap_storage&& other) noexcept
+        : fd(std::exchange(other.fd, -1)),
+          access_mode(other.access_mode),
+          region(std::exchange(other.region, checked_memory_storage { })) {
+    }
+
+    mmap_storage(const mmap_storage&) = delete;
+    mmap_storage& operator=(const mmap_storage&) = delete;
+    mmap_storage& operator=(mmap_storage&&) = delete;
+
+    ~mmap_storage() {
+        unmap();
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    void seek(std::ptrdiff_t num_bytes) {
+        region.seek(num_bytes);
+    }
+
+    void load(std::byte* target, std::size_t num_bytes) {
+        region.load(target, num_bytes);
+    }
+
+    /// @throws storage_io_exception if the storage was opened in read_only mode
+    void store(std::byte* source, std::size_t num_bytes) {
+        check_writable();
+        region.store(source, num_bytes);
+    }
+
+    void require(std::size_t num_bytes) const {
+        region.require(num_bytes);
+    }
+
+    /// @throws storage_io_exception if the storage was opened in read_only mode
+    void require_store(std::size_t num_bytes) const {
+        check_writable();
+        region.require(num_bytes);
+    }
+
+    memory_storage& unchecked() {
+        return region.unchecked();
+    }
+
+    /**
+     * Returns a pointer to the next num_bytes bytes of the mapping without
+     * copying them and advances the cursor past them
+     */
+    const std::byte* view(std::size_t num_bytes) {
+        region.require(num_bytes);
+        auto ret = region.current;
+        region.current += num_bytes;
+        return ret;
+    }
+
+    /// Hints the expected access pattern for the entire mapping to the operating system
+    void advise(access_hint hint) {
+        advise(hint, 0, size());
+    }
+
+    /// Hints the expected access pattern for the given byte range of the mapping to the operating system
+    void advise(access_hint hint, std::size_t offset, std::size_t length) {
+        if (size() == 0) {
+            return;
+        }
+
+        // madvise requires a page-aligned start address
+        auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        auto aligned_offset = offset - offset % page_size;
+        length += offset - aligned_offset;
+
+        int advice = MADV_NORMAL;
+        switch (hint) {
+        case access_hint::normal:     advice = MADV_NORMAL; break;
+        case access_hint::sequential: advice = MADV_SEQUENTIAL; break;
+        case access_hint::random:     advice = MADV_RANDOM; break;
+        case access_hint::willneed:   advice = MADV_WILLNEED; break;
+        }
+
+        if (::madvise(region.buffer_begin + aligned_offset, length, advice) != 0) {
+            throw storage_io_exception { errno };
+        }
+    }
+
+    /**
+     * Changes the size of the underlying file and remaps it. The cursor
+     * position is retained (relative to the beginning of the file), but moved
+     * to the new end of the file if it would lie past it.
+     * @pre The storage was opened in read_write mode
+     * @throws storage_io_exception on error
+     */
+    void resize(std::size_t new_size) {
+        check_writable();
+
+        auto offset = position();
+        auto old_size = size();
+        unmap();
+        if (::ftruncate(fd, static_cast<off_t>(new_size)) != 0) {
+            // Restore the previous mapping so that the storage remains usable
+            auto error = errno;
+            try {
+                map(old_size);
+                region.current = region.buffer_begin + offset;
+            } catch (storage_io_exception&) {
+                // The storage is left empty. Report the original error
+            }
+            throw storage_io_exception { error };
+        }
+        map(new_size);
+        region.current = region.buffer_begin + std::min(offset, new_size);
+    }
+
+    /// Writes modified pages back to the file
+    void sync() {
+        if (size() != 0 && ::msync(region.buffer_begin, size(), MS_SYNC) != 0) {
+            throw storage_io_exception { errno };
+        }
+    }
+
+    std::byte* data() {
+        return region.buffer_begin;
+    }
+
+    const std::byte* data() const {
+        return region.buffer_begin;
+    }
+
+    std::size_t size() const {
+        return static_cast<std::size_t>(region.buffer_end - region.buffer_begin);
+    }
+
+    /// Offset of the cursor from the beginning of the file
+    std::size_t position() const {
+        return static_cast<std::size_t>(region.current - region.buffer_begin);
+    }
+
+    /// Number of bytes between the cursor and the end of the file
+    std::size_t remaining() const {
+        return region.remaining();
+    }
+
+private:
+    void check_writable() const {
+        if (access_mode != mode::read_write) {
+            throw storage_io_exception { EBADF };
+        }
+    }
+
+    void map(std::size_t size) {
+        if (size == 0) {
+            // Empty files can't be mapped
+            region = checked_memory_storage { };
+            return;
+        }
+
+        auto protection = PROT_READ | (access_mode == mode::read_write ? PROT_WRITE : 0);
+        auto mapping = ::mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            throw storage_io_exception { errno };
+        }
+
+        auto begin = static_cast<std::byte*>(mapping);
+        region = checked_memory_storage { { begin, begin, begin + size } };
+    }
+
+    void unmap() {
+        if (region.buffer_begin) {
+            ::munmap(region.buffer_begin, size());
+            region = checked_memory_storage { };
+        }
+    }
+
+    int fd = -1;
+    mode access_mode;
+
+    // Mapped file contents and current cursor
+    checked_memory_storage region { };
+};
+
+} // namespace blob
+
+#endif // BLOBIFY_MMAP_STORAGE_HPP
@@ -2,10 +2,43 @@
 #define BLOBIFY_MODIFY_HPP
 
 #include "load.hpp"
+#include "memory_storage.hpp"
 #include "store.hpp"
 
 namespace blob {
 
+namespace detail {
+
+template<auto PointerToMember1, auto... PointersToMember>
+constexpr void lens_validate() {
+    using Data = typename pmd_traits_t<PointerToMember1>::parent_type;
+    generic_validate<Data>();
+    static_assert(is_valid_pmd_chain_v<Data, decltype(PointerToMember1), decltype(PointersToMember)...>,
+                  "Given list of pointers-to-member does not form a valid member lookup chain");
+    static_assert(is_fixed_size<Data>(), "Member offsets of aggregates with variable-length members are not known statically");
+}
+
+/**
+ * Fused lens_load and lens_store for the serialized blob at the given address:
+ * Decodes the member in place, applies f and encodes the result to the same location
+ */
+template<typename ConstructionPolicy, auto... PointersToMember, typename F>
+void lens_modify_at(std::byte* blob, F& f) {
+    using Target = lens_target<PointersToMember...>;
+    using Parent = typename Target::leaf_parent_type;
+    using MemberType = typename Target::member_type;
+    static_assert(!is_bit_field_member<Parent, Target::leaf_index>(), "Bit-field members share their word with other members and hence can't be stored individually");
+    constexpr auto& member_properties = member_properties_for<Parent, Target::leaf_index>;
+
+    auto address = blob + Target::offset;
+    memory_storage member_storage { address, address, address + total_serialized_size<MemberType>() };
+    MemberType value = f(load_element<MemberType, &member_properties, memory_storage, ConstructionPolicy>(member_storage));
+    member_storage.current = address;
+    store_element<&member_properties, memory_storage, ConstructionPolicy>(member_storage, value);
+}
+
+} // namespace detail
+
 template<auto PointerToMember1,
          auto... PointersToMember,
          typename F,
@@ -25,9 +58,61 @@ template<auto PointerToMember1,
          typename ConstructionPolicy = detail::default_construction_policy>
 constexpr void lens_modify(Storage&& storage, F&& f,
                          [[maybe_unused]] tag<ConstructionPolicy> construction_policy_tag = { }) {
-    // Create a copy of the input storage to get independent read/write pointers, then defer to the version with separate source and target storages
-    Storage target_storage = storage;
-    lens_modify<PointerToMember1, PointersToMember...>(std::forward<Storage>(storage), std::move(target_storage), std::forward<F>(f), construction_policy_tag);
+    using StorageType = std::remove_reference_t<Storage>;
+    if constexpr (detail::is_contiguous_storage_v<StorageType>) {
+        // Modify the member in place without moving the cursor
+        using Data = typename detail::pmd_traits_t<PointerToMember1>::parent_type;
+        detail::lens_validate<PointerToMember1, PointersToMember...>();
+        auto&& target = detail::checked_modify_access(storage, detail::total_serialized_size<Data>());
+        detail::lens_modify_at<ConstructionPolicy, PointerToMember1, PointersToMember...>(target.current, f);
+    } else if constexpr (std::is_copy_constructible_v<StorageType>) {
+        // Create a copy of the input storage to get independent read/write pointers, then defer to the version with separate source and target storages
+        Storage target_storage = storage;
+        lens_modify<PointerToMember1, PointersToMember...>(std::forward<Storage>(storage), std::move(target_storage), std::forward<F>(f), construction_policy_tag);
+    } else {
+        // Storages owning resources can't be copied.
+        // Since lens_load seeks back to the beginning of the blob, the same storage can be used for the store
+        lens_modify<PointerToMember1, PointersToMember...>(storage, storage, std::forward<F>(f), construction_policy_tag);
+    }
+}
+
+/**
+ * Applies lens_modify to count consecutive serialized blobs, starting at the
+ * current position of the storage. The storage is moved back to the
+ * beginning of the first blob afterwards.
+ *
+ * For contiguous storages (such as memory_storage or mmap_storage), this is
+ * a single loop that updates the members in memory, with one bounds check for
+ * all blobs and no seeks.
+ *
+ * @note If f or member validation throws, preceding blobs have been modified already
+ */
+template<auto PointerToMember1,
+         auto... PointersToMember,
+         typename F,
+         typename Storage,
+         typename ConstructionPolicy = detail::default_construction_policy>
+void lens_modify_many(Storage&& storage, std::size_t count, F&& f,
+                      [[maybe_unused]] tag<ConstructionPolicy> construction_policy_tag = { }) {
+    using Data = typename detail::pmd_traits_t<PointerToMember1>::parent_type;
+    detail::lens_validate<PointerToMember1, PointersToMember...>();
+    constexpr auto stride = detail::total_serialized_size<Data>();
+
+    auto&& target = detail::checked_modify_access(storage, stride, count);
+    using TargetStorage = std::remove_reference_t<decltype(target)>;
+    if constexpr (std::is_base_of_v<memory_storage, TargetStorage>) {
+        auto blob = target.current;
+        for (std::size_t index = 0; index < count; ++index) {
+            detail::lens_modify_at<ConstructionPolicy, PointerToMember1, PointersToMember...>(blob + index * stride, f);
+        }
+    } else {
+        detail::lens_rewinder<TargetStorage> rewinder { target };
+        for (std::size_t index = 0; index < count; ++index) {
+            lens_modify<PointerToMember1, PointersToMember...>(target, f, construction_policy_tag);
+            target.seek(stride);
+            rewinder.position += stride;
+        }
+    }
 }
 
 } // namespace blob
@@ -0,0 +1,237 @@
+#ifndef BLOBIFY_PARALLEL_HPP
+#define BLOBIFY_PARALLEL_HPP
+
+#include "load.hpp"
+#include "memory_storage.hpp"
+#include "store.hpp"
+
+#include "detail/is_vector.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace blob {
+
+/**
+ * Executor that runs tasks on up to num_threads threads, including the calling thread.
+ *
+ * Executors passed to the parallel load/store functions must provide
+ * execute(num_tasks, task), which invokes task(i) exactly once for each i in
+ * [0, num_tasks) and returns once all invocations have completed. The tasks
+ * passed by blobify don't throw.
+ *
+ * If a thread can't be started, thread_executor waits for the threads
+ * started so far and rethrows the std::system_error.
+ */
+struct thread_executor {
+    std::size_t num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    template<typename Task>
+    void execute(std::size_t num_tasks, Task&& task) const {
+        std::atomic<std::size_t> next_task { 0 };
+        auto worker = [&] {
+            for (std::size_t index; (index = next_task.fetch_add(1)) < num_tasks;) {
+                task(index);
+            }
+        };
+
+        auto num_workers = std::max<std::size_t>(std::min(num_threads, num_tasks), 1);
+        std::vector<std::thread> threads;
+        auto join_all = [&] {
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        };
+
+        try {
+            threads.reserve(num_workers - 1);
+            for (std::size_t i = 1; i < num_workers; ++i) {
+                threads.emplace_back(worker);
+            }
+        } catch (...) {
+            // Destroying joinable threads would terminate the program.
+            // Let the started threads finish their tasks before reporting the error
+            join_all();
+            throw;
+        }
+        worker();
+        join_all();
+    }
+};
+
+namespace detail {
+
+/**
+ * Splits count elements of element_size bytes each into num_chunks chunks at
+ * fixed offsets of the given contiguous storage and processes each of them
+ * using its own storage cursor.
+ *
+ * If any chunk fails, the exception of the first failing chunk is rethrown,
+ * which is the exception the sequential operation would have thrown.
+ *
+ * @post On success, the storage cursor is advanced past all elements
+ */
+template<typename Executor, typename ChunkFunc>
+void for_each_chunk_parallel(memory_storage& storage, std::size_t element_size, std::size_t count,
+                             Executor&& executor, std::size_t num_chunks, ChunkFunc&& chunk_func) {
+    if (count == 0) {
+        return;
+    }
+
+    num_chunks = std::clamp<std::size_t>(num_chunks, 1, count);
+    std::vector<std::exception_ptr> errors(num_chunks);
+
+    executor.execute(num_chunks, [&](std::size_t chunk) {
+        // Distribute the remainder over the first chunks
+        auto first = chunk * (count / num_chunks) + std::min(chunk, count % num_chunks);
+        auto chunk_size = count / num_chunks + (chunk < count % num_chunks);
+
+        memory_storage cursor = storage;
+        cursor.current += first * element_size;
+        try {
+            chunk_func(cursor, first, chunk_size);
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    });
+
+    for (auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    storage.current += count * element_size;
+}
+
+} // namespace detail
+
+/**
+ * Variant of load_many_explicit that decodes the elements in parallel using
+ * the given executor.
+ *
+ * Since all elements have the same serialized size, the input is split into
+ * num_chunks chunks at fixed offsets. This requires a contiguous storage, i.e.
+ * memory_storage or a storage providing one via unchecked() (such as
+ * checked_memory_storage or mmap_storage).
+ *
+ * @post Advances the storage as load_many_explicit would
+ * @note If decoding fails, the exception of the first invalid element is rethrown
+ */
+template<typename ContainerData,
+         const properties_t<typename ContainerData::value_type>* Properties,
+         typename Storage,
+         typename Executor,
+         typename ConstructionPolicy = detail::default_construction_policy>
+ContainerData load_many_explicit_parallel(Storage&& storage, std::size_t count, Executor&& executor, std::size_t num_chunks,
+                                          tag<ConstructionPolicy> = {}) {
+    using Data = typename ContainerData::value_type;
+    static_assert(detail::is_std_vector_v<ContainerData> && std::is_default_constructible_v<Data> && !std::is_same_v<Data, bool>,
+                  "Parallel loading requires a std::vector of default-constructible elements");
+    static_assert(detail::is_fixed_size<Data>(), "Parallel loading requires fixed-size elements");
+
+    constexpr auto element_size = detail::total_serialized_size<Data>();
+    auto&& source = detail::checked_access(storage, element_size, count);
+    static_assert(std::is_base_of_v<memory_storage, std::remove_reference_t<decltype(source)>>,
+                  "Parallel loading requires a contiguous storage");
+
+    ContainerData container(count);
+    detail::for_each_chunk_parallel(source, element_size, count, executor, num_chunks,
+                                    [&](memory_storage& cursor, std::size_t first, std::size_t chunk_size) {
+        detail::load_elements_into<Properties, memory_storage, ConstructionPolicy>(cursor, container.data() + first, chunk_size);
+    });
+    return container;
+}
+
+/**
+ * Variant of load_many that decodes the elements in parallel using the given executor.
+ * See load_many_explicit_parallel for details.
+ */
+template<typename ContainerData,
+         typename Storage,
+         typename Executor,
+         typename ConstructionPolicy = detail::default_construction_policy,
+         typename = std::enable_if_t<!std::is_integral_v<std::remove_reference_t<Executor>>>>
+ContainerData load_many_parallel(Storage&& storage, std::size_t count, Executor&& executor, std::size_t num_chunks,
+                                 tag<ConstructionPolicy> tag = {}) {
+    using Data = typename ContainerData::value_type;
+    static_assert(detail::has_deducible_properties<Data>, "Data properties are not implicitly deducible. Use load_many_explicit_parallel instead");
+    constexpr auto Properties = &detail::properties_for<Data>;
+    return load_many_explicit_parallel<ContainerData, Properties>(storage, count, executor, num_chunks, tag);
+}
+
+/**
+ * Variant of load_many that decodes the elements in parallel on num_threads
+ * threads. See load_many_explicit_parallel for details.
+ */
+template<typename ContainerData,
+         typename Storage,
+         typename ConstructionPolicy = detail::default_construction_policy>
+ContainerData load_many_parallel(Storage&& storage, std::size_t count, std::size_t num_threads,
+                                 tag<ConstructionPolicy> tag = {}) {
+    return load_many_parallel<ContainerData>(storage, count, thread_executor { num_threads }, num_threads, tag);
+}
+
+/**
+ * Variant of store_many_explicit that encodes the elements in parallel using
+ * the given executor. Like load_many_explicit_parallel, this requires a
+ * contiguous storage.
+ *
+ * @post Advances the storage as store_many_explicit would
+ */
+template<auto Properties,
+         typename Storage,
+         typename Executor,
+         typename ConstructionPolicy = detail::default_construction_policy,
+         typename Data>
+void store_many_explicit_parallel(Storage&& storage, const std::vector<Data>& data, Executor&& executor, std::size_t num_chunks,
+                                  tag<ConstructionPolicy> = {}) {
+    static_assert(!std::is_same_v<Data, bool>, "Parallel storing is not supported for std::vector<bool>");
+    static_assert(detail::is_fixed_size<Data>(), "Parallel storing requires fixed-size elements");
+
+    constexpr auto element_size = detail::total_serialized_size<Data>();
+    auto&& target = detail::checked_store_access(storage, element_size, data.size());
+    static_assert(std::is_base_of_v<memory_storage, std::remove_reference_t<decltype(target)>>,
+                  "Parallel storing requires a contiguous storage");
+
+    detail::for_each_chunk_parallel(target, element_size, data.size(), executor, num_chunks,
+                                    [&](memory_storage& cursor, std::size_t first, std::size_t chunk_size) {
+        detail::store_elements<Properties, memory_storage, ConstructionPolicy>(cursor, data.data() + first, chunk_size);
+    });
+}
+
+/**
+ * Variant of store_many that encodes the elements in parallel using the given executor.
+ * See store_many_explicit_parallel for details.
+ */
+template<typename Storage,
+         typename Executor,
+         typename ConstructionPolicy = detail::default_construction_policy,
+         typename Data,
+         typename = std::enable_if_t<!std::is_integral_v<std::remove_reference_t<Executor>>>>
+void store_many_parallel(Storage&& storage, const std::vector<Data>& data, Executor&& executor, std::size_t num_chunks,
+                         tag<ConstructionPolicy> tag = {}) {
+    static_assert(detail::has_deducible_properties<Data>, "Data properties are not implicitly deducible. Use store_many_explicit_parallel instead");
+    constexpr auto Properties = &detail::properties_for<Data>;
+    store_many_explicit_parallel<Properties>(storage, data, executor, num_chunks, tag);
+}
+
+/**
+ * Variant of store_many that encodes the elements in parallel on num_threads
+ * threads. See store_many_explicit_parallel for details.
+ */
+template<typename Storage,
+         typename ConstructionPolicy = detail::default_construction_policy,
+         typename Data>
+void store_many_parallel(Storage&& storage, const std::vector<Data>& data, std::size_t num_threads,
+                         tag<ConstructionPolicy> tag = {}) {
+    store_many_parallel(storage, data, thread_executor { num_threads }, num_threads, tag);
+}
+
+} // namespace blob
+
+#endif // BLOBIFY_PARALLEL_HPP
@@ -3,14 +3,18 @@
 
 #include "tag.hpp"
 #include "detail/is_array.hpp"
+#include "detail/is_variable_length.hpp"
 #include "detail/pmd_traits.hpp"
 #include "endian.hpp"
 
 #include <boost/pfr/core.hpp>
 
+#include <array>
 #include <cstdint>
 #include <cstddef>
+#include <limits>
 #include <optional>
+#include <type_traits>
 
 namespace blob {
 
@@ -22,18 +26,25 @@ constexpr auto select_representative() {
     static_assert(!std::is_pointer_v<T>, "select_representative may not be called on pointers");
 
     // Class types and unoipns are not supported (unless it's an std::array)
-    static_assert((!std::is_class_v<T> && !std::is_union_v<T>) || detail::is_std_array_v<T>, "select_representative may not be called on class/union types");
+    static_assert((!std::is_class_v<T> && !std::is_union_v<T>) || detail::is_std_array_v<T> || detail::is_variable_length_v<T>,
+                  "select_representative may not be called on class/union types");
 
-    static_assert(!std::is_floating_point_v<T>, "select_representative is not implemented for floating point types, yet");
-
-    if constexpr (detail::is_std_array_v<T>) {
-        return select_representative<typename T::value_type>();
+    if constexpr (detail::is_std_array_v<T> || detail::is_variable_length_v<T>) {
+        return select_representative<detail::array_element_t<T>>();
     } else if constexpr (std::is_enum_v<T>) {
         return std::underlying_type_t<T> { };
+    } else if constexpr (std::is_floating_point_v<T>) {
+        // Floating-point values are represented by their bit pattern, which allows for byte swapping
+        static_assert(std::numeric_limits<T>::is_iec559 && (sizeof(T) == 4 || sizeof(T) == 8),
+                      "Only IEEE 754 single and double precision floating point types are supported");
+        if constexpr (sizeof(T) == 4) {
+            return uint32_t { };
+        } else {
+            return uint64_t { };
+        }
     } else {
         static_assert(std::is_integral_v<T>, "Unexpected non-integral type. This is a bug.");
 
-        // TODO: detect floating points, too!
         if constexpr (std::is_signed_v<T>) {
             if constexpr (sizeof(T) == 1) {
                 return int8_t { };
@@ -64,13 +75,28 @@ constexpr auto select_representative() {
 
 struct no_representative_type {};
 
+/// Placeholder value type for properties that are not supported by a member
+struct unsupported_property {};
+
+/// Checks if the in-memory representation of T is identical to that of its representative type
+template<typename T>
+inline constexpr bool is_plain_representation_v = std::is_enum_v<T> || std::is_floating_point_v<T> || (std::is_integral_v<T> && !std::is_same_v<T, bool>);
+
 } // namespace detail
 
 
 /// Properties of concrete members to load. Parent may be void for standalone data
 template<typename T, typename Parent>
 struct element_properties_t {
-    std::optional<T> expected_value;
+    using value_type = T;
+
+    /**
+     * Value the loaded element is compared against. For std::array members, the array contents are compared as a whole.
+     * Not supported for variable-length members or aggregates containing them.
+     *
+     * On validation error, an unexpected_value_exception is thrown
+     */
+    std::optional<std::conditional_t<detail::contains_variable_length<T>(), detail::unsupported_property, T>> expected_value;
 
     /**
      * Validate enums using a quick check on the enum bounds defined by the smallest and the largest value
@@ -99,7 +125,45 @@ struct element_properties_t {
      */
     endian endianness = endian::native;
 
-    static constexpr bool has_representative_type = (!std::is_class_v<T> && !std::is_union_v<T>) || detail::is_std_array_v<T>;
+    /**
+     * For integral, enum and bool members: Number of bits occupied in a packed word, or 0 if the member is not a bit-field.
+     *
+     * Adjacent bit-field members share a single word, starting from its least
+     * significant bit. Their widths must add up to 8, 16, 32 or 64 bits, and
+     * they must have the same endianness. Consecutive words can be described
+     * using nested aggregates.
+     *
+     * Signed members are sign-extended on load. On store, values are truncated to the bit width.
+     */
+    std::size_t bit_width = 0;
+
+    static constexpr std::size_t no_count_member = static_cast<std::size_t>(-1);
+
+    /**
+     * For variable-length members (std::vector, std::basic_string, std::basic_string_view, std::span):
+     * Index of the preceding integral member that holds the number of elements.
+     * Elements are serialized in place of the variable-length member.
+     *
+     * On store, the count member is written from the size of the variable-length member.
+     * Views (std::basic_string_view, std::span) refer to the storage memory directly
+     * and hence require a contiguous storage such as memory_storage or mmap_storage.
+     */
+    std::size_t count_member_index = no_count_member;
+
+    /**
+     * Sets count_member_index to the index of the given member.
+     * If several members share the type of the count member, the parent
+     * must be constexpr-constructible, which requires C++20 for owning
+     * containers. Otherwise, set count_member_index manually.
+     */
+    template<auto PointerToCountMember>
+    constexpr element_properties_t& count_member() {
+        count_member_index = detail::pmd_to_member_index<Parent, PointerToCountMember>(std::make_index_sequence<boost::pfr::tuple_size_v<Parent>> { });
+        return *this;
+    }
+
+    static constexpr bool has_representative_type = (!std::is_class_v<T> && !std::is_union_v<T>) || detail::is_std_array_v<T> ||
+                                                    (detail::is_variable_length_v<T> && !std::is_class_v<detail::array_element_t<T>>);
     /// Type of @a representative passed to construction_policy for decoding/encoding the actual value
     using representative_type = std::conditional_t<has_representative_type,
                                                    // Wrapping MemberType in a conditional_t to prevent select_representative from failing its static_asserts if !has_representative_type
@@ -175,46 +239,372 @@ inline constexpr auto member_properties_for = properties_for<Data>.template memb
 template<typename Data>
 constexpr std::size_t total_serialized_size();
 
+/// Classification of a member by the code path used to load/store it
+enum class member_kind : std::uint8_t {
+    integral,
+    enumeration,
+    boolean,
+    floating_point,
+    array,
+    aggregate,
+    variable_length,
+    bit_field
+};
+
+/**
+ * Serialized layout and properties of a single aggregate member.
+ *
+ * Loading and storing aggregates dispatches on the member kind, and checking
+ * serialized data skips members without validation based on this table.
+ * The validation checks themselves are driven by element_properties_t, which
+ * also describe standalone elements without a parent aggregate.
+ */
+struct member_layout {
+    /// Offset from the beginning of the parent. For members following a variable-length member, this excludes the variable-length data
+    std::size_t offset = 0;
+    /// Serialized size. For members of variable size, this excludes the variable-length data
+    std::size_t size = 0;
+    bool fixed_size = true;
+    std::size_t count_member_index = static_cast<std::size_t>(-1);
+    /// For bit-field members, position within the word at offset. The first bit-field of a word holds the word size, the others have size 0
+    std::size_t bit_offset = 0;
+    std::size_t bit_width = 0;
+    std::size_t word_size = 0;
+    member_kind kind = member_kind::integral;
+    endian endianness = endian::native;
+    /// Whether loading the member involves any runtime validation (expected_value, validate_enum, validate_enum_bounds), including validation of nested members
+    bool has_validation = false;
+};
+
+/**
+ * Serialized layout of all members of an aggregate.
+ *
+ * This is computed once per type in a single pass over its members, so
+ * offset and size queries don't require any further template instantiations.
+ */
+template<std::size_t NumMembers>
+struct aggregate_layout {
+    std::array<member_layout, NumMembers> members { };
+    std::size_t size = 0;
+    bool fixed_size = true;
+    bool has_bit_fields = false;
+    bool has_validation = false;
+};
+
+template<typename Data>
+constexpr bool is_fixed_size();
+
+/// Position of a bit-field member within the word it shares with adjacent bit-field members
+struct bit_field_position {
+    std::size_t first_index = 0;
+    std::size_t bit_offset = 0;
+    std::size_t word_bits = 0;
+};
+
+template<typename Data, std::size_t... Idxs>
+constexpr auto bit_widths_for(std::index_sequence<Idxs...>) {
+    return std::array<std::size_t, sizeof...(Idxs)> { member_properties_for<Data, Idxs>.bit_width... };
+}
+
 template<typename Data, std::size_t Idx>
-constexpr std::size_t member_size_for() {
-    constexpr auto props = member_properties_for<Data, Idx>;
-    if constexpr (props.has_representative_type) {
-        constexpr auto representative_size = sizeof(typename decltype(props)::representative_type);
+constexpr bit_field_position bit_field_position_for() {
+    constexpr auto widths = bit_widths_for<Data>(std::make_index_sequence<boost::pfr::tuple_size_v<Data>> { });
+    bit_field_position position;
+    position.first_index = Idx;
+    while (position.first_index > 0 && widths[position.first_index - 1] != 0) {
+        --position.first_index;
+    }
+    for (std::size_t index = position.first_index; index < Idx; ++index) {
+        position.bit_offset += widths[index];
+    }
+    for (std::size_t index = position.first_index; index < widths.size() && widths[index] != 0; ++index) {
+        position.word_bits += widths[index];
+    }
+    return position;
+}
+
+template<typename Member>
+constexpr member_kind member_kind_for() {
+    if constexpr (detail::is_variable_length_v<Member>) {
+        return member_kind::variable_length;
+    } else if constexpr (detail::is_std_array_v<Member>) {
+        return member_kind::array;
+    } else if constexpr (std::is_class_v<Member>) {
+        return member_kind::aggregate;
+    } else if constexpr (std::is_enum_v<Member>) {
+        return member_kind::enumeration;
+    } else if constexpr (std::is_same_v<Member, bool>) {
+        return member_kind::boolean;
+    } else if constexpr (std::is_floating_point_v<Member>) {
+        return member_kind::floating_point;
+    } else {
+        return member_kind::integral;
+    }
+}
+
+template<typename Element>
+constexpr bool has_nested_validation();
 
-        using member_type = boost::pfr::tuple_element_t<Idx, Data>;
+template<typename Data, std::size_t Idx>
+constexpr member_layout make_member_layout(std::size_t offset) {
+    constexpr auto& props = member_properties_for<Data, Idx>;
+    using member_type = boost::pfr::tuple_element_t<Idx, Data>;
+
+    member_layout layout;
+    layout.offset = offset;
+    if constexpr (detail::is_variable_length_v<member_type>) {
+        constexpr auto count_index = props.count_member_index;
+        static_assert(count_index != props.no_count_member, "Variable-length members require a count member");
+        static_assert(count_index < Idx, "The count member must precede the variable-length member");
+        if constexpr (count_index < Idx) {
+            using count_type = boost::pfr::tuple_element_t<count_index, Data>;
+            static_assert(std::is_integral_v<count_type> && !std::is_same_v<count_type, bool>, "The count member must be of integral type");
+        }
+        static_assert(is_fixed_size<array_element_t<member_type>>(), "Elements of variable-length members must have a fixed size");
+        layout.fixed_size = false;
+        layout.count_member_index = count_index;
+        layout.kind = member_kind::variable_length;
+    } else if constexpr (props.bit_width != 0) {
+        static_assert(!std::is_class_v<member_type> && !std::is_floating_point_v<member_type>, "Bit-field members must be of integral, enum or bool type");
+        using representative_type = typename std::remove_reference_t<decltype(props)>::representative_type;
+        static_assert(props.bit_width <= 8 * sizeof(representative_type), "Bit width exceeds the size of the member type");
+        constexpr auto position = bit_field_position_for<Data, Idx>();
+        static_assert(position.word_bits == 8 || position.word_bits == 16 || position.word_bits == 32 || position.word_bits == 64,
+                      "Widths of adjacent bit-field members must add up to 8, 16, 32 or 64 bits");
+        static_assert(props.endianness == member_properties_for<Data, position.first_index>.endianness,
+                      "Bit-field members sharing a word must have the same endianness");
+        layout.word_size = position.word_bits / 8;
+        layout.bit_offset = position.bit_offset;
+        layout.bit_width = props.bit_width;
+        // The word is accounted for by its first member
+        layout.offset = (position.bit_offset == 0) ? offset : offset - layout.word_size;
+        layout.size = (position.bit_offset == 0) ? layout.word_size : 0;
+        layout.kind = member_kind::bit_field;
+    } else if constexpr (props.has_representative_type) {
+        constexpr auto representative_size = sizeof(typename std::remove_reference_t<decltype(props)>::representative_type);
         if constexpr (detail::is_std_array_v<member_type>) {
-            return representative_size * std::tuple_size_v<member_type>;
+            layout.size = representative_size * std::tuple_size_v<member_type>;
         } else {
-            return representative_size;
+            layout.size = representative_size;
         }
+        layout.kind = member_kind_for<member_type>();
     } else {
-        return total_serialized_size<boost::pfr::tuple_element_t<Idx, Data>>();
+        layout.size = total_serialized_size<member_type>();
+        layout.fixed_size = is_fixed_size<member_type>();
+        layout.kind = member_kind_for<member_type>();
     }
+    layout.endianness = props.endianness;
+    layout.has_validation = props.expected_value.has_value() || props.validate_enum || props.validate_enum_bounds ||
+                            has_nested_validation<array_element_t<member_type>>();
+    return layout;
 }
 
-template<typename Data, std::size_t Idx>
-constexpr std::size_t member_offset_for() {
-    if constexpr (Idx == 0) {
-        return 0;
+template<typename Data, std::size_t... Idxs>
+constexpr auto make_aggregate_layout(std::index_sequence<Idxs...>) {
+    aggregate_layout<sizeof...(Idxs)> layout;
+    ((layout.members[Idxs] = make_member_layout<Data, Idxs>(layout.size), layout.size += layout.members[Idxs].size), ...);
+    layout.fixed_size = (layout.members[Idxs].fixed_size && ...);
+    layout.has_bit_fields = ((layout.members[Idxs].kind == member_kind::bit_field) || ...);
+    layout.has_validation = (layout.members[Idxs].has_validation || ...);
+    return layout;
+}
+
+/// Serialized layout of the aggregate Data
+template<typename Data>
+inline constexpr auto layout_for = make_aggregate_layout<Data>(std::make_index_sequence<boost::pfr::tuple_size_v<Data>> { });
+
+/// Whether elements of type Element are aggregates with validated members
+template<typename Element>
+constexpr bool has_nested_validation() {
+    if constexpr (detail::is_std_array_v<Element>) {
+        return has_nested_validation<typename Element::value_type>();
+    } else if constexpr (std::is_class_v<Element> && !detail::is_variable_length_v<Element>) {
+        return layout_for<Element>.has_validation;
     } else {
-        // Build up offset via recursion
-        return member_size_for<Data, Idx - 1>() + member_offset_for<Data, Idx - 1>();
+        return false;
     }
 }
 
+template<typename Data, std::size_t Idx>
+constexpr std::size_t member_size_for() {
+    return layout_for<Data>.members[Idx].size;
+}
+
+template<typename Data, std::size_t Idx>
+constexpr std::size_t member_offset_for() {
+    return layout_for<Data>.members[Idx].offset;
+}
+
+/**
+ * Serialized size of Data. For types containing variable-length members, this
+ * is the size of all fixed-size data, i.e. the serialized size if all
+ * variable-length members are empty.
+ */
 template<typename Data>
 constexpr std::size_t total_serialized_size() {
     if constexpr (detail::is_std_array_v<Data>) {
         return std::tuple_size_v<Data> * total_serialized_size<typename Data::value_type>();
     } else if constexpr (std::is_class_v<Data>) {
-        constexpr auto size = boost::pfr::tuple_size_v<Data>;
-        // Add the size of the last member to its offset
-        return member_offset_for<Data, size>();
+        return layout_for<Data>.size;
     } else {
         return sizeof(select_representative<Data>());
     }
 }
 
+/// Checks if the serialized size of Data is independent of its value, i.e. if it doesn't contain any variable-length members
+template<typename Data>
+constexpr bool is_fixed_size() {
+    if constexpr (detail::is_variable_length_v<Data>) {
+        return false;
+    } else if constexpr (detail::is_std_array_v<Data>) {
+        return is_fixed_size<typename Data::value_type>();
+    } else if constexpr (std::is_class_v<Data>) {
+        return layout_for<Data>.fixed_size;
+    } else {
+        return true;
+    }
+}
+
+template<typename Data, std::size_t Idx>
+constexpr bool is_bit_field_member() {
+    return layout_for<Data>.members[Idx].kind == member_kind::bit_field;
+}
+
+template<typename Data, std::size_t Idx>
+constexpr bool is_variable_length_member() {
+    return layout_for<Data>.members[Idx].kind == member_kind::variable_length;
+}
+
+/// Unsigned integer type of the given size, used to hold packed bit-field members
+template<std::size_t Size>
+using bit_field_word_t = std::conditional_t<Size == 1, std::uint8_t,
+                         std::conditional_t<Size == 2, std::uint16_t,
+                         std::conditional_t<Size == 4, std::uint32_t, std::uint64_t>>>;
+
+/// Calls f with an integral_constant for the index of each bit-field member sharing the word of the member at FirstIdx
+template<typename Data, std::size_t FirstIdx, typename F, std::size_t... Offsets>
+constexpr void for_each_bit_field_in_word(F&& f, std::index_sequence<Offsets...>) {
+    (f(std::integral_constant<std::size_t, FirstIdx + Offsets> { }), ...);
+}
+
+/// Index past the last bit-field member sharing the word of the member at FirstIdx
+template<typename Data, std::size_t FirstIdx>
+constexpr std::size_t bit_field_word_end() {
+    constexpr auto& layout = layout_for<Data>;
+    std::size_t index = FirstIdx + 1;
+    while (index < layout.members.size() && layout.members[index].bit_width != 0 && layout.members[index].bit_offset != 0) {
+        ++index;
+    }
+    return index;
+}
+
+template<typename Data, std::size_t FirstIdx, typename F>
+constexpr void for_each_bit_field_in_word(F&& f) {
+    for_each_bit_field_in_word<Data, FirstIdx>(f, std::make_index_sequence<bit_field_word_end<Data, FirstIdx>() - FirstIdx> { });
+}
+
+/// Static lookup of the member referred to by a chain of pointers-to-member
+template<auto PointerToMember1, auto... PointersToMember>
+struct lens_target {
+    using parent_type = typename pmd_traits_t<PointerToMember1>::parent_type;
+    using next = lens_target<PointersToMember...>;
+
+    using member_type = typename next::member_type;
+    using leaf_parent_type = typename next::leaf_parent_type;
+    static constexpr std::size_t leaf_index = next::leaf_index;
+
+    /// Offset of the member from the beginning of parent_type
+    static constexpr std::size_t offset =
+            member_offset_for<parent_type, pmd_to_member_index<parent_type, PointerToMember1>(std::make_index_sequence<boost::pfr::tuple_size_v<parent_type>> { })>() +
+            next::offset;
+};
+
+template<auto PointerToMember>
+struct lens_target<PointerToMember> {
+    using parent_type = typename pmd_traits_t<PointerToMember>::parent_type;
+
+    using member_type = typename pmd_traits_t<PointerToMember>::member_type;
+    using leaf_parent_type = parent_type;
+    static constexpr std::size_t leaf_index = pmd_to_member_index<parent_type, PointerToMember>(std::make_index_sequence<boost::pfr::tuple_size_v<parent_type>> { });
+
+    static constexpr std::size_t offset = member_offset_for<parent_type, leaf_index>();
+};
+
+/**
+ * Layout of a batch of lens accesses to direct members of Data. The accesses
+ * are ordered by their serialized offset so that they can be performed in a
+ * single forward pass over the blob.
+ */
+template<typename Data, auto... PointersToMember>
+struct lens_batch {
+    static constexpr std::size_t size = sizeof...(PointersToMember);
+
+    static constexpr std::array<std::size_t, size> member_indices = {
+        pmd_to_member_index<Data, PointersToMember>(std::make_index_sequence<boost::pfr::tuple_size_v<Data>> { })...
+    };
+
+    /// Offset of each access. Bit-field members are accessed through their entire word
+    static constexpr std::array<std::size_t, size> offsets = {
+        layout_for<Data>.members[pmd_to_member_index<Data, PointersToMember>(std::make_index_sequence<boost::pfr::tuple_size_v<Data>> { })].offset...
+    };
+
+    static constexpr std::array<std::size_t, size> sizes = [] {
+        std::array<std::size_t, size> ret { };
+        for (std::size_t access = 0; access < size; ++access) {
+            auto& member = layout_for<Data>.members[member_indices[access]];
+            ret[access] = member.bit_width ? member.word_size : member.size;
+        }
+        return ret;
+    }();
+
+    /// Indexes of the accesses sorted by offset (keeping the given order for equal offsets)
+    static constexpr std::array<std::size_t, size> order = [] {
+        std::array<std::size_t, size> ret { };
+        for (std::size_t access = 0; access < size; ++access) {
+            auto pos = access;
+            for (; pos > 0 && offsets[ret[pos - 1]] > offsets[access]; --pos) {
+                ret[pos] = ret[pos - 1];
+            }
+            ret[pos] = access;
+        }
+        return ret;
+    }();
+
+    /// Whether the access at the given position in the sorted order reads the same bit-field word as its predecessor
+    static constexpr bool shares_previous_word(std::size_t pos) {
+        return pos > 0 && layout_for<Data>.members[member_indices[order[pos]]].bit_width != 0 &&
+               layout_for<Data>.members[member_indices[order[pos - 1]]].bit_width != 0 &&
+               offsets[order[pos]] == offsets[order[pos - 1]];
+    }
+
+    /// Offset past the data accessed up to (excluding) the given position in the sorted order
+    static constexpr std::size_t end_before(std::size_t pos) {
+        return pos == 0 ? 0 : offsets[order[pos - 1]] + sizes[order[pos - 1]];
+    }
+
+    /// Checks that the accessed members don't overlap, except for bit-fields sharing a word
+    static constexpr bool is_disjoint() {
+        for (std::size_t pos = 1; pos < size; ++pos) {
+            if (offsets[order[pos]] < end_before(pos) && !shares_previous_word(pos)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/// Index of the first variable-length member using the member at CountIdx as its count member, if any
+template<typename Data, std::size_t CountIdx>
+constexpr std::size_t counted_member_for() {
+    constexpr auto& layout = layout_for<Data>;
+    for (std::size_t index = CountIdx + 1; index < layout.members.size(); ++index) {
+        if (layout.members[index].count_member_index == CountIdx) {
+            return index;
+        }
+    }
+    return static_cast<std::size_t>(-1);
+}
+
 template<typename Data>
 constexpr void generic_validate() {
     constexpr auto props = properties(make_tag<Data>);
@@ -229,8 +619,69 @@ constexpr void generic_validate() {
     }
 }
 
+template<typename Data, bool Validate = true>
+constexpr bool is_trivially_blobifiable_aggregate();
+
+/**
+ * Checks if the serialized representation of an element with the given
+ * properties is bytewise identical to its in-memory representation.
+ * This requires native endianness and no validation to be applied.
+ *
+ * If Validate is false, validation properties are ignored, e.g. for data
+ * that has been validated before.
+ */
+template<typename T, auto member_props, bool Validate = true>
+constexpr bool is_trivially_blobifiable_element() {
+    if constexpr (detail::is_variable_length_v<T>) {
+        return false;
+    } else if constexpr (detail::is_std_array_v<T>) {
+        // Properties of std::array members apply to each of their elements
+        return is_trivially_blobifiable_element<typename T::value_type, member_props, Validate>() &&
+               sizeof(T) == std::tuple_size_v<T> * sizeof(typename T::value_type);
+    } else if constexpr (std::is_class_v<T>) {
+        return is_trivially_blobifiable_aggregate<T, Validate>();
+    } else if constexpr (is_plain_representation_v<T>) {
+        return (!Validate || (!member_props->expected_value &&
+                              !member_props->validate_enum &&
+                              !member_props->validate_enum_bounds)) &&
+               member_props->bit_width == 0 &&
+               member_props->endianness == endian::native;
+    } else {
+        return false;
+    }
+}
+
+template<typename Data, bool Validate, std::size_t... Idxs>
+constexpr bool are_members_trivially_blobifiable(std::index_sequence<Idxs...>) {
+    return (is_trivially_blobifiable_element<boost::pfr::tuple_element_t<Idxs, Data>, &member_properties_for<Data, Idxs>, Validate>() && ...);
+}
+
+template<typename Data, bool Validate>
+constexpr bool is_trivially_blobifiable_aggregate() {
+    if constexpr (std::is_trivially_copyable_v<Data> && std::is_trivially_default_constructible_v<Data>) {
+        // Matching sizes guarantee there is no padding in between members
+        return total_serialized_size<Data>() == sizeof(Data) &&
+               are_members_trivially_blobifiable<Data, Validate>(std::make_index_sequence<boost::pfr::tuple_size_v<Data>> { });
+    } else {
+        return false;
+    }
+}
+
 } // namespace detail
 
+/**
+ * Indicates whether the serialized layout of T (as given by its properties)
+ * matches its in-memory layout, such that it can be loaded/stored by copying
+ * its object representation as a whole
+ */
+template<typename T>
+struct is_trivially_blobifiable
+        : std::bool_constant<detail::is_trivially_blobifiable_element<T, &detail::properties_for<T>>()> {
+};
+
+template<typename T>
+inline constexpr bool is_trivially_blobifiable_v = is_trivially_blobifiable<T>::value;
+
 } // namespace blob
 
 #endif // BLOBIFY_PROPERTIES_HPP
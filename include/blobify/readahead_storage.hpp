@@ -0,0 +1,315 @@
+#ifndef BLOBIFY_READAHEAD_STORAGE_HPP
+#define BLOBIFY_READAHEAD_STORAGE_HPP
+
+#include "exceptions.hpp"
+#include "storage_backend.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace blob {
+
+/**
+ * Input storage adapter that reads ahead from the underlying storage on a
+ * background thread.
+ *
+ * Data is read in blocks of block_size bytes into a ring of num_blocks
+ * buffers (double buffering by default). While the loading thread decodes
+ * one block, the background thread fills the next ones, so sequential loads
+ * such as load_many() over slow files don't wait for each read to complete.
+ *
+ * Seeks within the buffered data don't access the underlying storage. Other
+ * seeks pause the background thread, discard the buffered data and are
+ * forwarded to the underlying storage, so they behave as they would on the
+ * underlying storage itself.
+ *
+ * The underlying storage must provide read_some(target, max_bytes) (such as
+ * istream_storage) or remaining(), and must not be accessed directly while
+ * the readahead_storage is alive. Errors encountered by the background thread
+ * are rethrown once the data buffered before them has been consumed.
+ */
+template<typename Storage>
+class readahead_storage {
+public:
+    static constexpr std::size_t default_block_size = 64 * 1024;
+    static constexpr std::size_t default_num_blocks = 2;
+
+    /// @throws std::invalid_argument if block_size is zero
+    explicit readahead_storage(Storage& storage, std::size_t block_size = default_block_size,
+                               std::size_t num_blocks = default_num_blocks)
+        : storage(storage), block_size(block_size), blocks(std::max<std::size_t>(num_blocks, 2)) {
+        static_assert(detail::has_read_some<Storage>::value || detail::has_remaining<Storage>::value,
+                      "readahead_storage requires storages providing read_some() or remaining()");
+        if (block_size == 0) {
+            // Empty blocks would never make progress
+            throw std::invalid_argument("readahead_storage block_size must be non-zero");
+        }
+        for (auto& block : blocks) {
+            block.data = std::make_unique<std::byte[]>(block_size);
+        }
+        current = blocks[0].data.get();
+        reader = std::thread { [this] { read_blocks(); } };
+    }
+
+    // The background thread refers to this object, so it can't be copied or moved
+    readahead_storage(const readahead_storage&) = delete;
+    readahead_storage& operator=(const readahead_storage&) = delete;
+
+    ~readahead_storage() {
+        {
+            std::lock_guard lock { mutex };
+            stopping = true;
+        }
+        can_read.notify_one();
+        reader.join();
+    }
+
+    void seek(std::ptrdiff_t num_bytes) {
+        auto target = static_cast<std::ptrdiff_t>(block_pos) + num_bytes;
+        if (target >= 0 && target <= static_cast<std::ptrdiff_t>(block_end)) {
+            block_pos = static_cast<std::size_t>(target);
+            return;
+        }
+
+        std::unique_lock lock { mutex };
+        if (target > 0 && skip_buffered(static_cast<std::size_t>(target))) {
+            return;
+        }
+
+        // Wait for the background thread to finish its current read before accessing the storage
+        paused = true;
+        has_read.wait(lock, [this] { return !busy; });
+
+        std::exception_ptr seek_error;
+        // NOTE: The target position may have been read in the meantime
+        if (target <= 0 || !skip_buffered(static_cast<std::size_t>(target))) {
+            // The underlying storage is positioned at the end of the buffered data
+            auto num_buffered = static_cast<std::ptrdiff_t>(block_end - block_pos);
+            for (std::size_t i = has_block; i < num_filled; ++i) {
+                num_buffered += static_cast<std::ptrdiff_t>(blocks[(read_index + i) % blocks.size()].size);
+            }
+            release_all();
+
+            try {
+                storage.seek(num_bytes - num_buffered);
+            } catch (...) {
+                seek_error = std::current_exception();
+            }
+        }
+
+        paused = false;
+        can_read.notify_one();
+        if (seek_error) {
+            std::rethrow_exception(seek_error);
+        }
+    }
+
+    /// @throws storage_exhausted_exception if the end of the underlying storage is reached
+    void load(std::byte* target, std::size_t num_bytes) {
+        if (num_bytes <= block_end - block_pos) {
+            std::memcpy(target, current + block_pos, num_bytes);
+            block_pos += num_bytes;
+            return;
+        }
+
+        if (read_some(target, num_bytes) != num_bytes) {
+            throw storage_exhausted_exception { };
+        }
+    }
+
+    /**
+     * Reads up to max_bytes bytes, stopping early at the end of the underlying storage
+     * @return Number of bytes read
+     */
+    std::size_t read_some(std::byte* target, std::size_t max_bytes) {
+        std::size_t num_read = 0;
+        while (num_read < max_bytes) {
+            if (block_pos == block_end && !next_block()) {
+                break;
+            }
+            auto chunk_size = std::min(max_bytes - num_read, block_end - block_pos);
+            std::memcpy(target + num_read, current + block_pos, chunk_size);
+            block_pos += chunk_size;
+            num_read += chunk_size;
+        }
+        return num_read;
+    }
+
+private:
+    struct block {
+        std::unique_ptr<std::byte[]> data;
+
+        // Number of valid bytes. Only blocks at the end of the underlying storage are partially filled
+        std::size_t size = 0;
+    };
+
+    /// Background thread function that fills free blocks until stopped
+    void read_blocks() {
+        std::unique_lock lock { mutex };
+        while (true) {
+            can_read.wait(lock, [this] {
+                return stopping || (!paused && !at_end && !error && num_filled < blocks.size());
+            });
+            if (stopping) {
+                return;
+            }
+
+            // The loading thread doesn't access blocks past the filled ones, so this one can be written without locking
+            auto& target = blocks[(read_index + num_filled) % blocks.size()];
+            busy = true;
+            lock.unlock();
+            std::exception_ptr read_error;
+            std::size_t num_read = 0;
+            try {
+                fill(target.data.get(), num_read);
+            } catch (...) {
+                read_error = std::current_exception();
+            }
+            lock.lock();
+            busy = false;
+
+            target.size = num_read;
+            if (num_read) {
+                ++num_filled;
+            }
+            at_end = (num_read < block_size);
+            error = read_error;
+            has_read.notify_one();
+        }
+    }
+
+    /**
+     * Reads up to block_size bytes from the underlying storage, stopping early only at its end
+     * @param num_read Number of bytes read so far, which remain valid if an exception is thrown
+     */
+    void fill(std::byte* target, std::size_t& num_read) {
+        if constexpr (detail::has_read_some<Storage>::value) {
+            while (num_read < block_size) {
+                auto chunk_size = storage.read_some(target + num_read, block_size - num_read);
+                if (chunk_size == 0) {
+                    break;
+                }
+                num_read += chunk_size;
+            }
+        } else {
+            auto num_bytes = std::min<std::size_t>(storage.remaining(), block_size);
+            storage.load(target, num_bytes);
+            num_read = num_bytes;
+        }
+    }
+
+    /**
+     * Releases the current block and waits for the next one to be filled
+     * @return false if the end of the underlying storage has been reached
+     */
+    bool next_block() {
+        std::unique_lock lock { mutex };
+        release_current();
+        has_read.wait(lock, [this] { return num_filled || at_end || error; });
+        if (!num_filled) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            return false;
+        }
+        acquire_current();
+        return true;
+    }
+
+    /**
+     * Moves the cursor offset bytes past the beginning of the current block
+     * if the target position has already been read
+     *
+     * @pre The mutex is locked
+     * @return false if the target position lies beyond the buffered data
+     */
+    bool skip_buffered(std::size_t offset) {
+        // Find the filled block containing the target position, counting the current block as the first one
+        std::size_t index = has_block;
+        offset -= std::min(offset, block_end);
+        for (; index < num_filled; ++index) {
+            auto size = blocks[(read_index + index) % blocks.size()].size;
+            if (offset < size || (offset == size && index + 1 == num_filled)) {
+                break;
+            }
+            offset -= size;
+        }
+        if (index == num_filled) {
+            return false;
+        }
+
+        // Release all blocks before it
+        read_index = (read_index + index) % blocks.size();
+        num_filled -= index;
+        if (index) {
+            can_read.notify_one();
+        }
+        acquire_current();
+        block_pos = offset;
+        return true;
+    }
+
+    /// @pre The mutex is locked
+    void release_current() {
+        if (has_block) {
+            read_index = (read_index + 1) % blocks.size();
+            --num_filled;
+            has_block = false;
+            can_read.notify_one();
+        }
+        block_pos = block_end = 0;
+    }
+
+    /// @pre The mutex is locked and at least one block is filled
+    void acquire_current() {
+        current = blocks[read_index].data.get();
+        block_pos = 0;
+        block_end = blocks[read_index].size;
+        has_block = true;
+    }
+
+    /// Discards all buffered data. @pre The mutex is locked and the background thread is paused
+    void release_all() {
+        block_pos = block_end = 0;
+        has_block = false;
+        read_index = num_filled = 0;
+        at_end = false;
+        error = nullptr;
+    }
+
+    Storage& storage;
+    std::size_t block_size;
+    std::vector<block> blocks;
+
+    // State of the loading thread: The current block and the read cursor within it
+    const std::byte* current;
+    std::size_t block_pos = 0;
+    std::size_t block_end = 0;
+
+    // State shared with the background thread, guarded by the mutex
+    std::mutex mutex;
+    std::condition_variable can_read; // Notifies the background thread
+    std::condition_variable has_read; // Notifies the loading thread
+    std::size_t read_index = 0; // Index of the first filled block (the current one if has_block is set)
+    std::size_t num_filled = 0; // Number of filled blocks, including the current one
+    bool has_block = false;
+    bool at_end = false;
+    bool busy = false;
+    bool paused = false;
+    bool stopping = false;
+    std::exception_ptr error;
+
+    std::thread reader;
+};
+
+} // namespace blob
+
+#endif // BLOBIFY_READAHEAD_STORAGE_HPP
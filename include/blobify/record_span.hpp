@@ -0,0 +1,224 @@
+#ifndef BLOBIFY_RECORD_SPAN_HPP
+#define BLOBIFY_RECORD_SPAN_HPP
+
+#include "load.hpp"
+#include "memory_storage.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace blob {
+
+/**
+ * Non-owning view of consecutive serialized records of type T in contiguous memory.
+ *
+ * Records are located at fixed offsets of total_serialized_size<T>() bytes and
+ * are only decoded when accessed. Individual members can be loaded without
+ * decoding the rest of the record:
+ *
+ *     blob::record_span<Pixel> pixels { storage, count };
+ *     auto red = pixels[i].get<&Pixel::r>();
+ *
+ * The underlying memory must outlive the record_span.
+ */
+template<typename T, typename ConstructionPolicy = detail::default_construction_policy>
+class record_span {
+    static_assert(detail::is_fixed_size<T>(), "record_span requires records of fixed size");
+
+public:
+    static constexpr std::size_t record_size = detail::total_serialized_size<T>();
+
+    /// Proxy for a single serialized record
+    class reference {
+    public:
+        /// Decodes the entire record
+        T load() const {
+            return blob::load<T>(storage(), tag<ConstructionPolicy> { });
+        }
+
+        operator T() const {
+            return load();
+        }
+
+        /// Decodes a single (possibly nested) member of the record, as if by lens_load
+        template<auto PointerToMember1, auto... PointersToMember>
+        auto get() const {
+            static_assert(std::is_same_v<typename detail::pmd_traits_t<PointerToMember1>::parent_type, T>,
+                          "Pointer-to-member must refer to a member of the record type");
+            return lens_load<PointerToMember1, PointersToMember...>(storage(), tag<ConstructionPolicy> { });
+        }
+
+        /// Pointer to the serialized record
+        const std::byte* data() const {
+            return record;
+        }
+
+    private:
+        friend class record_span;
+
+        explicit reference(const std::byte* record) : record(record) {
+        }
+
+        memory_storage storage() const {
+            // NOTE: Loads don't modify the underlying memory, so casting away const is fine
+            auto begin = const_cast<std::byte*>(record);
+            return memory_storage { begin, begin, begin + record_size };
+        }
+
+        const std::byte* record;
+    };
+
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = typename record_span::reference;
+
+        iterator() = default;
+
+        reference operator*() const {
+            return reference { record };
+        }
+
+        reference operator[](difference_type n) const {
+            return *(*this + n);
+        }
+
+        iterator& operator++() {
+            record += record_size;
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto ret = *this;
+            ++*this;
+            return ret;
+        }
+
+        iterator& operator--() {
+            record -= record_size;
+            return *this;
+        }
+
+        iterator operator--(int) {
+            auto ret = *this;
+            --*this;
+            return ret;
+        }
+
+        iterator& operator+=(difference_type n) {
+            record += n * static_cast<difference_type>(record_size);
+            return *this;
+        }
+
+        iterator& operator-=(difference_type n) {
+            return *this += -n;
+        }
+
+        friend iterator operator+(iterator it, difference_type n) {
+            return it += n;
+        }
+
+        friend iterator operator+(difference_type n, iterator it) {
+            return it += n;
+        }
+
+        friend iterator operator-(iterator it, difference_type n) {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const iterator& a, const iterator& b) {
+            return (a.record - b.record) / static_cast<difference_type>(record_size);
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b) { return a.record == b.record; }
+        friend bool operator!=(const iterator& a, const iterator& b) { return a.record != b.record; }
+        friend bool operator<(const iterator& a, const iterator& b) { return a.record < b.record; }
+        friend bool operator>(const iterator& a, const iterator& b) { return a.record > b.record; }
+        friend bool operator<=(const iterator& a, const iterator& b) { return a.record <= b.record; }
+        friend bool operator>=(const iterator& a, const iterator& b) { return a.record >= b.record; }
+
+    private:
+        friend class record_span;
+
+        explicit iterator(const std::byte* record) : record(record) {
+        }
+
+        const std::byte* record = nullptr;
+    };
+
+    /// Views count records starting at the given address
+    record_span(const std::byte* data, std::size_t count) : records(data), count(count) {
+    }
+
+    /**
+     * Views count records starting at the cursor of the given contiguous
+     * storage. The storage cursor is not advanced.
+     *
+     * @throws storage_exhausted_exception if a bounds-checked storage holds fewer than count records
+     */
+    template<typename Storage, typename = std::enable_if_t<!std::is_pointer_v<std::decay_t<Storage>>>>
+    record_span(Storage&& storage, std::size_t count) : count(count) {
+        auto&& source = detail::checked_access(storage, record_size, count);
+        static_assert(std::is_base_of_v<memory_storage, std::remove_reference_t<decltype(source)>>,
+                      "record_span requires a contiguous storage");
+        records = source.current;
+    }
+
+    std::size_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    /// @pre index < size()
+    reference operator[](std::size_t index) const {
+        return reference { records + index * record_size };
+    }
+
+    /// @throws std::out_of_range if index >= size()
+    reference at(std::size_t index) const {
+        if (index >= count) {
+            throw std::out_of_range("record_span index out of range");
+        }
+        return (*this)[index];
+    }
+
+    /// Decodes the record at the given index
+    T load(std::size_t index) const {
+        return (*this)[index].load();
+    }
+
+    /// Decodes a single member of the record at the given index, as if by lens_load
+    template<auto PointerToMember1, auto... PointersToMember>
+    auto get(std::size_t index) const {
+        return (*this)[index].template get<PointerToMember1, PointersToMember...>();
+    }
+
+    iterator begin() const {
+        return iterator { records };
+    }
+
+    iterator end() const {
+        return iterator { records + count * record_size };
+    }
+
+    /// Pointer to the first serialized record
+    const std::byte* data() const {
+        return records;
+    }
+
+private:
+    const std::byte* records = nullptr;
+    std::size_t count = 0;
+};
+
+} // namespace blob
+
+#endif // BLOBIFY_RECORD_SPAN_HPP
@@ -0,0 +1,128 @@
+#ifndef BLOBIFY_RESULT_HPP
+#define BLOBIFY_RESULT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace blob {
+
+/// Reason for a failed try_* operation. Corresponds to the exception thrown by the throwing variant
+enum class error_kind : std::uint8_t {
+    storage_exhausted,  ///< See storage_exhausted_exception
+    unexpected_value,   ///< See unexpected_value_exception
+    invalid_enum_value, ///< See invalid_enum_value_exception
+    invalid_length,     ///< See invalid_length_exception
+    storage_io,         ///< See storage_io_exception
+};
+
+/**
+ * Compact description of a failed try_* operation.
+ *
+ * Values are reported as integers (enums via their underlying value). For
+ * std::array members, the offending array element is reported.
+ */
+struct error_info {
+    error_kind kind;
+
+    /// Index of the offending member within its (innermost) parent aggregate
+    std::size_t member_index = 0;
+
+    /// Offset of the offending element from the beginning of the accessed data
+    std::size_t byte_offset = 0;
+
+    /// Expected value for unexpected_value errors, 0 otherwise. Floating-point values are reported by their bit pattern
+    std::int64_t expected = 0;
+
+    /**
+     * Offending value for unexpected_value and invalid_enum_value errors,
+     * offending number of elements for invalid_length errors, and error
+     * number (errno) for storage_io errors. 0 otherwise. Floating-point
+     * values are reported by their bit pattern
+     */
+    std::int64_t actual = 0;
+};
+
+/**
+ * Either a value of type T or an error_info describing why it could not be produced
+ */
+template<typename T>
+class result {
+public:
+    result(T value) : storage(std::in_place_index<0>, std::move(value)) {
+    }
+
+    result(const error_info& error) : storage(std::in_place_index<1>, error) {
+    }
+
+    bool has_value() const {
+        return storage.index() == 0;
+    }
+
+    explicit operator bool() const {
+        return has_value();
+    }
+
+    /// @pre has_value()
+    T& value() & {
+        return *std::get_if<0>(&storage);
+    }
+
+    /// @pre has_value()
+    const T& value() const & {
+        return *std::get_if<0>(&storage);
+    }
+
+    /// @pre has_value()
+    T&& value() && {
+        return std::move(*std::get_if<0>(&storage));
+    }
+
+    T& operator*() & { return value(); }
+    const T& operator*() const & { return value(); }
+    T&& operator*() && { return std::move(*this).value(); }
+
+    T* operator->() { return &value(); }
+    const T* operator->() const { return &value(); }
+
+    /// @pre !has_value()
+    const error_info& error() const {
+        return *std::get_if<1>(&storage);
+    }
+
+private:
+    std::variant<T, error_info> storage;
+};
+
+/// Result of operations that don't produce a value
+template<>
+class result<void> {
+public:
+    result() = default;
+
+    result(const error_info& error) : error_(error) {
+    }
+
+    bool has_value() const {
+        return !error_.has_value();
+    }
+
+    explicit operator bool() const {
+        return has_value();
+    }
+
+    /// @pre !has_value()
+    const error_info& error() const {
+        return *error_;
+    }
+
+private:
+    std::optional<error_info> error_;
+};
+
+} // namespace blob
+
+#endif // BLOBIFY_RESULT_HPP
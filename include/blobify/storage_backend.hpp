@@ -1,7 +1,18 @@
 #ifndef BLOBIFY_STORAGE_BACKEND_HPP
 #define BLOBIFY_STORAGE_BACKEND_HPP
 
+#include "exceptions.hpp"
+#include "memory_storage.hpp"
+#include "properties.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
 #include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
 
 namespace blob {
 
@@ -35,14 +46,684 @@ struct output_storage : storage_base {
 
 };
 
+/**
+ * Optional interface for storages that check accesses against their bounds.
+ *
+ * Such storages are checked once per top-level operation (load, store,
+ * load_many, ...) for the total size of the accessed data. The individual
+ * member accesses are then performed through unchecked().
+ */
+struct bounds_checked_storage : storage_base {
+    /**
+     * @throws storage_exhausted_exception if num_bytes bytes can't be accessed starting from the cursor
+     */
+    void require(std::size_t num_bytes);
+
+    /**
+     * Returns a storage that shares its cursor with this one but doesn't check any bounds.
+     *
+     * This may also return a storage by value, which is then used for the
+     * remainder of the top-level operation and destroyed at its end.
+     */
+    storage_base& unchecked();
+
+    /**
+     * Optional variant of require() used before storing data through unchecked().
+     * Storages that may be read-only should provide this to reject stores.
+     *
+     * @throws storage_exhausted_exception if num_bytes bytes can't be accessed starting from the cursor
+     */
+    void require_store(std::size_t num_bytes);
+};
+
+/**
+ * Optional interface for output storages that can defer copying stored data.
+ *
+ * Ranges that are part of the data passed to a top-level operation (store,
+ * store_many, ...) are stored through store_borrowed() rather than store().
+ * The storage may keep referring to such ranges until release_borrowed() is
+ * called at the end of the top-level operation, which also happens if the
+ * operation throws.
+ */
+struct borrowing_storage : output_storage {
+    /**
+     * @pre source stays valid until the next call to release_borrowed()
+     */
+    void store_borrowed(const std::byte* source, std::size_t num_bytes);
+
+    /**
+     * @post The storage doesn't refer to any data passed to store_borrowed() anymore
+     */
+    void release_borrowed();
+};
+
+/**
+ * Optional interface for storages that process the accessed data in batches,
+ * such as the contiguous view used by hashing_storage.
+ *
+ * Operations on many elements split them into chunks of about
+ * checkpoint_interval bytes and call checkpoint() after each chunk. This
+ * allows the storage to process the data accessed since its last checkpoint
+ * while it's still in cache.
+ */
+struct checkpointing_storage : storage_base {
+    static constexpr std::size_t checkpoint_interval = 0;
+
+    void checkpoint();
+};
+
 namespace detail {
 
-// Type-erased abstraction for a runtime-provided backend
-// TODO: Also buffer on fixed-size array first
-struct default_storage_backend {
-    // TODO
+template<typename Storage, typename = void>
+struct is_bounds_checked_storage : std::false_type {};
+
+template<typename Storage>
+struct is_bounds_checked_storage<Storage, std::void_t<decltype(std::declval<Storage&>().require(std::size_t { })),
+                                                     decltype(std::declval<Storage&>().unchecked())>>
+        : std::true_type {};
+
+template<typename Storage>
+inline constexpr bool is_bounds_checked_storage_v = is_bounds_checked_storage<Storage>::value;
+
+template<typename Storage, typename = void>
+struct has_require_store : std::false_type {};
+
+template<typename Storage>
+struct has_require_store<Storage, std::void_t<decltype(std::declval<Storage&>().require_store(std::size_t { }))>>
+        : std::true_type {};
+
+/**
+ * Prepares the storage for accessing count consecutive elements of element_size
+ * bytes each and returns the storage to be used for the individual accesses.
+ *
+ * For bounds-checked storages, this performs a single check for the entire
+ * range and returns the unchecked storage.
+ */
+template<typename Storage>
+constexpr decltype(auto) checked_access(Storage& storage, std::size_t element_size, std::size_t count = 1) {
+    if constexpr (is_bounds_checked_storage_v<Storage>) {
+        if (element_size != 0 && count > std::numeric_limits<std::size_t>::max() / element_size) {
+            throw storage_exhausted_exception { };
+        }
+        storage.require(element_size * count);
+        return storage.unchecked();
+    } else {
+        return (storage);
+    }
+}
+
+/**
+ * Variant of checked_access for storing data. This uses require_store() rather
+ * than require() for storages that provide it.
+ */
+template<typename Storage>
+constexpr decltype(auto) checked_store_access(Storage& storage, std::size_t element_size, std::size_t count = 1) {
+    if constexpr (has_require_store<Storage>::value) {
+        if (element_size != 0 && count > std::numeric_limits<std::size_t>::max() / element_size) {
+            throw storage_exhausted_exception { };
+        }
+        storage.require_store(element_size * count);
+        return storage.unchecked();
+    } else {
+        return checked_access(storage, element_size, count);
+    }
+}
+
+/**
+ * Variant of checked_access for modifying previously stored data in place.
+ * The data must exist already, so this checks require() in addition to require_store()
+ */
+template<typename Storage>
+constexpr decltype(auto) checked_modify_access(Storage& storage, std::size_t element_size, std::size_t count = 1) {
+    checked_access(storage, element_size, count);
+    return checked_store_access(storage, element_size, count);
+}
+
+/// Whether top-level operations on the given storage access its memory directly
+template<typename Storage>
+constexpr bool is_contiguous_storage_v =
+        std::is_base_of_v<memory_storage, std::remove_reference_t<decltype(checked_access(std::declval<Storage&>(), 0))>>;
+
+/**
+ * checked_access for count consecutive elements of type Data.
+ *
+ * The serialized size of data with variable-length members is only known
+ * while accessing it, so for such data the storage is returned as is and
+ * checks its bounds on each access.
+ */
+template<typename Data, typename Storage>
+constexpr decltype(auto) checked_access_for(Storage& storage, std::size_t count = 1) {
+    if constexpr (is_fixed_size<Data>()) {
+        return checked_access(storage, total_serialized_size<Data>(), count);
+    } else {
+        return (storage);
+    }
+}
+
+/// checked_store_access for count consecutive elements of type Data
+template<typename Data, typename Storage>
+constexpr decltype(auto) checked_store_access_for(Storage& storage, std::size_t count = 1) {
+    if constexpr (is_fixed_size<Data>()) {
+        return checked_store_access(storage, total_serialized_size<Data>(), count);
+    } else {
+        return (storage);
+    }
+}
+
+template<typename Storage, typename = void>
+struct has_read_some : std::false_type {};
+
+template<typename Storage>
+struct has_read_some<Storage, std::void_t<decltype(std::declval<Storage&>().read_some(std::declval<std::byte*>(), std::size_t { }))>>
+        : std::true_type {};
+
+template<typename Storage, typename = void>
+struct has_load : std::false_type {};
+
+template<typename Storage>
+struct has_load<Storage, std::void_t<decltype(std::declval<Storage&>().load(std::declval<std::byte*>(), std::size_t { }))>>
+        : std::true_type {};
+
+template<typename Storage, typename = void>
+struct has_store : std::false_type {};
+
+template<typename Storage>
+struct has_store<Storage, std::void_t<decltype(std::declval<Storage&>().store(std::declval<std::byte*>(), std::size_t { }))>>
+        : std::true_type {};
+
+template<typename Storage, typename = void>
+struct has_remaining : std::false_type {};
+
+template<typename Storage>
+struct has_remaining<Storage, std::void_t<decltype(std::declval<const Storage&>().remaining())>>
+        : std::true_type {};
+
+template<typename Storage, typename = void>
+struct is_growable_storage : std::false_type {};
+
+/// Storages that grow on require_store() rather than reporting exhaustion (such as vector_storage)
+template<typename Storage>
+struct is_growable_storage<Storage, std::enable_if_t<Storage::growable>> : std::true_type {};
+
+template<typename Storage, typename = void>
+struct is_borrowing_storage : std::false_type {};
+
+template<typename Storage>
+struct is_borrowing_storage<Storage, std::void_t<decltype(std::declval<Storage&>().store_borrowed(std::declval<const std::byte*>(), std::size_t { })),
+                                                decltype(std::declval<Storage&>().release_borrowed())>>
+        : std::true_type {};
+
+template<typename Storage, typename = void>
+struct is_checkpointing_storage : std::false_type {};
+
+template<typename Storage>
+struct is_checkpointing_storage<Storage, std::void_t<decltype(std::declval<Storage&>().checkpoint())>>
+        : std::true_type {};
+
+/**
+ * Performs a bulk transfer of count elements of element_size bytes each by
+ * calling transfer(first, num_elements). For checkpointing storages, the
+ * transfer is split into chunks of at most checkpoint_interval bytes.
+ */
+template<typename Storage, typename Transfer>
+constexpr void transfer_in_chunks(Storage& storage, std::size_t element_size, std::size_t count, Transfer&& transfer) {
+    if constexpr (is_checkpointing_storage<Storage>::value) {
+        const auto chunk_size = std::max<std::size_t>(Storage::checkpoint_interval / std::max<std::size_t>(element_size, 1), 1);
+        for (std::size_t first = 0; first < count; first += chunk_size) {
+            transfer(first, std::min(chunk_size, count - first));
+            storage.checkpoint();
+        }
+    } else {
+        transfer(std::size_t { 0 }, count);
+    }
+}
+
+/// Variant of transfer_in_chunks that calls access(index) for each element individually
+template<typename Storage, typename Access>
+constexpr void access_in_chunks(Storage& storage, std::size_t element_size, std::size_t count, Access&& access) {
+    transfer_in_chunks(storage, element_size, count, [&](std::size_t first, std::size_t num_elements) {
+        for (std::size_t i = first; i < first + num_elements; ++i) {
+            access(i);
+        }
+    });
+}
+
+/**
+ * Stores a range of the data passed to the current top-level operation,
+ * without copying it for storages that support borrowing
+ */
+template<typename Storage>
+constexpr void store_borrowed(Storage& storage, const std::byte* source, std::size_t num_bytes) {
+    if constexpr (is_borrowing_storage<Storage>::value) {
+        storage.store_borrowed(source, num_bytes);
+    } else {
+        // NOTE: Storage backends don't modify the source data, so casting away const is fine
+        storage.store(const_cast<std::byte*>(source), num_bytes);
+    }
+}
+
+/**
+ * Scope of a top-level store operation. For borrowing storages, this calls
+ * release_borrowed() upon release() or, if the operation is aborted by an
+ * exception, upon destruction
+ */
+template<typename Storage, bool = is_borrowing_storage<Storage>::value>
+struct borrow_scope {
+    constexpr explicit borrow_scope(Storage&) {
+    }
+
+    constexpr void release() {
+    }
+};
+
+template<typename Storage>
+struct borrow_scope<Storage, true> {
+    Storage& storage;
+    bool released = false;
+
+    explicit borrow_scope(Storage& storage) : storage(storage) {
+    }
+
+    borrow_scope(const borrow_scope&) = delete;
+    borrow_scope& operator=(const borrow_scope&) = delete;
+
+    void release() {
+        released = true;
+        storage.release_borrowed();
+    }
+
+    ~borrow_scope() {
+        if (!released) {
+            try {
+                storage.release_borrowed();
+            } catch (...) {
+                // The operation already failed with another exception
+            }
+        }
+    }
+};
+
+/// Seeks back to the beginning of a blob upon destruction, given the current position within the blob
+template<typename Storage>
+struct lens_rewinder {
+    Storage& storage;
+    std::size_t position = 0;
+
+    ~lens_rewinder() {
+        storage.seek(-static_cast<std::ptrdiff_t>(position));
+    }
+};
+
+/**
+ * Non-throwing counterpart of checked_access: Checks if count consecutive
+ * elements of element_size bytes each can be accessed. If this returns true,
+ * checked_access will succeed.
+ *
+ * Storages that aren't bounds-checked only report exhaustion when accessed,
+ * so this always returns true for them.
+ */
+template<typename Storage>
+bool can_access(Storage& storage, std::size_t element_size, std::size_t count = 1) {
+    if constexpr (!is_bounds_checked_storage_v<Storage>) {
+        return true;
+    } else if constexpr (has_remaining<Storage>::value) {
+        return element_size == 0 || count <= storage.remaining() / element_size;
+    } else {
+        // The storage can only report exhaustion by throwing
+        try {
+            checked_access(storage, element_size, count);
+            return true;
+        } catch (const storage_exhausted_exception&) {
+            return false;
+        }
+    }
+}
+
+/**
+ * Variant of can_access for storing data. Growable storages never run out of
+ * space, so this always returns true for them.
+ */
+template<typename Storage>
+bool can_store_access(Storage& storage, std::size_t element_size, std::size_t count = 1) {
+    if constexpr (is_growable_storage<Storage>::value) {
+        return true;
+    } else {
+        return can_access(storage, element_size, count);
+    }
+}
+
+/**
+ * Reads num_bytes bytes, reporting storage exhaustion through the return
+ * value rather than by throwing where the storage allows for it
+ *
+ * @return true on success. On failure, the storage may have been advanced partially
+ */
+template<typename Storage>
+bool try_read(Storage& storage, std::byte* target, std::size_t num_bytes) {
+    if constexpr (has_read_some<Storage>::value) {
+        while (num_bytes) {
+            auto num_read = storage.read_some(target, num_bytes);
+            if (num_read == 0) {
+                return false;
+            }
+            target += num_read;
+            num_bytes -= num_read;
+        }
+        return true;
+    } else if constexpr (is_bounds_checked_storage_v<Storage> && has_remaining<Storage>::value) {
+        if (storage.remaining() < num_bytes) {
+            return false;
+        }
+        storage.load(target, num_bytes);
+        return true;
+    } else {
+        try {
+            storage.load(target, num_bytes);
+            return true;
+        } catch (const storage_exhausted_exception&) {
+            return false;
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * Runtime-polymorphic storage interface for backends chosen at runtime.
+ *
+ * This is used through type_erased_storage, which buffers accesses such that
+ * these functions are called once per block of data rather than per member.
+ */
+class runtime_storage {
+public:
+    virtual ~runtime_storage() = default;
+
+    /**
+     * Reads at least min_bytes and at most max_bytes bytes into target
+     * @return Number of bytes read
+     * @throws storage_exhausted_exception if fewer than min_bytes bytes are available
+     */
+    virtual std::size_t read_some(std::byte* target, std::size_t min_bytes, std::size_t max_bytes) = 0;
+
+    /// @throws storage_exhausted_exception on error
+    virtual void write(const std::byte* source, std::size_t num_bytes) = 0;
+
+    virtual void seek(std::ptrdiff_t num_bytes) = 0;
+};
+
+/**
+ * Implements runtime_storage on top of a concrete storage (or a reference to one).
+ *
+ * Reads fetch as much data as possible in one go if the storage provides
+ * read_some(target, max_bytes) or remaining(). Otherwise, only the minimum
+ * number of requested bytes is read.
+ */
+template<typename Storage>
+class runtime_storage_adapter final : public runtime_storage {
+public:
+    explicit runtime_storage_adapter(Storage storage) : storage(std::forward<Storage>(storage)) {
+    }
+
+    std::size_t read_some(std::byte* target, std::size_t min_bytes, std::size_t max_bytes) override {
+        using StorageType = std::remove_reference_t<Storage>;
+        if constexpr (!detail::has_load<StorageType>::value) {
+            // Output-only storage
+            throw storage_io_exception { EBADF };
+        } else if constexpr (detail::has_read_some<StorageType>::value) {
+            auto num_bytes = storage.read_some(target, max_bytes);
+            if (num_bytes < min_bytes) {
+                throw storage_exhausted_exception { };
+            }
+            return num_bytes;
+        } else if constexpr (detail::has_remaining<StorageType>::value) {
+            auto available = storage.remaining();
+            if (available < min_bytes) {
+                throw storage_exhausted_exception { };
+            }
+            auto num_bytes = std::min(available, max_bytes);
+            storage.load(target, num_bytes);
+            return num_bytes;
+        } else {
+            storage.load(target, min_bytes);
+            return min_bytes;
+        }
+    }
+
+    void write(const std::byte* source, std::size_t num_bytes) override {
+        if constexpr (detail::has_store<std::remove_reference_t<Storage>>::value) {
+            // NOTE: Storage backends don't modify the source data, so casting away const is fine
+            storage.store(const_cast<std::byte*>(source), num_bytes);
+        } else {
+            // Input-only storage
+            throw storage_io_exception { EBADF };
+        }
+    }
+
+    void seek(std::ptrdiff_t num_bytes) override {
+        storage.seek(num_bytes);
+    }
+
+    /// Underlying storage
+    Storage& get() {
+        return storage;
+    }
+
+private:
+    Storage storage;
+};
+
+template<typename Storage>
+runtime_storage_adapter(Storage) -> runtime_storage_adapter<Storage>;
+
+/**
+ * Storage backend forwarding to a runtime_storage.
+ *
+ * Loads and stores are served from a fixed-size internal buffer, so that the
+ * virtual interface is only called once per refill/flush. This allows using
+ * a single instantiation of the load/store code paths for all storages that
+ * are selected at runtime.
+ *
+ * Since reads fetch data ahead of the cursor, the underlying storage may be
+ * positioned past the last loaded byte. Call flush() (or destroy the
+ * type_erased_storage) to write pending data and to seek the underlying storage
+ * back to the actual cursor. Note that the latter requires support for
+ * backward seeks.
+ */
+class type_erased_storage {
+public:
+    static constexpr std::size_t buffer_size = 4096;
+
+    explicit type_erased_storage(runtime_storage& backend) : backend(backend) {
+    }
+
+    type_erased_storage(const type_erased_storage&) = delete;
+    type_erased_storage& operator=(const type_erased_storage&) = delete;
+
+    ~type_erased_storage() {
+        try {
+            flush();
+        } catch (...) {
+            // Errors can't be reported from the destructor. This includes
+            // exceptions thrown by the runtime backend, such as std::ios_base::failure
+        }
+    }
+
+    void load(std::byte* target, std::size_t num_bytes) {
+        if (state == buffer_state::reading && num_bytes <= size - pos) {
+            std::memcpy(target, buffer.data() + pos, num_bytes);
+            pos += num_bytes;
+            return;
+        }
+        load_slow(target, num_bytes);
+    }
+
+    void store(std::byte* source, std::size_t num_bytes) {
+        if (state == buffer_state::writing && num_bytes <= buffer_size - pos) {
+            std::memcpy(buffer.data() + pos, source, num_bytes);
+            pos += num_bytes;
+            size = std::max(size, pos);
+            return;
+        }
+        store_slow(source, num_bytes);
+    }
+
+    void seek(std::ptrdiff_t num_bytes) {
+        if (state == buffer_state::idle) {
+            // Defer until the next access, which may then fetch the skipped data along with it
+            pending_seek += num_bytes;
+            return;
+        }
+
+        auto target = static_cast<std::ptrdiff_t>(pos) + num_bytes;
+        if (target >= 0 && target <= static_cast<std::ptrdiff_t>(size)) {
+            pos = static_cast<std::size_t>(target);
+            return;
+        }
+
+        if (state == buffer_state::reading && target > static_cast<std::ptrdiff_t>(size) &&
+            num_bytes <= static_cast<std::ptrdiff_t>(max_fill_size)) {
+            // Read short skipped ranges into the buffer, so that seeking back to them stays cheap (e.g. in lens_load)
+            fill(static_cast<std::size_t>(num_bytes));
+            pos += static_cast<std::size_t>(num_bytes);
+            return;
+        }
+
+        // Move the backend to the end of the buffered range and seek from there
+        if (state == buffer_state::writing) {
+            backend.write(buffer.data(), size);
+        }
+        auto offset = target - static_cast<std::ptrdiff_t>(size);
+        reset();
+        pending_seek = offset;
+    }
+
+    /**
+     * Writes any pending data and moves the underlying storage to the cursor position
+     */
+    void flush() {
+        if (state == buffer_state::writing) {
+            backend.write(buffer.data(), size);
+        }
+        auto offset = pending_seek + static_cast<std::ptrdiff_t>(pos) - static_cast<std::ptrdiff_t>(size);
+        reset();
+        if (offset != 0) {
+            backend.seek(offset);
+        }
+    }
+
+private:
+    enum class buffer_state {
+        // buffer is empty. The backend is positioned pending_seek bytes before the cursor
+        idle,
+
+        // buffer holds data read ahead of the cursor. The backend is positioned at the end of the buffered data
+        reading,
+
+        // buffer holds data to be written. The backend is positioned at the beginning of the buffered data
+        writing
+    };
+
+    void reset() {
+        state = buffer_state::idle;
+        pos = size = 0;
+        pending_seek = 0;
+    }
+
+    /**
+     * Reads data into the buffer such that at least num_bytes bytes are available after the cursor.
+     * Some of the data before the cursor is retained to allow for short backward seeks.
+     *
+     * @pre num_bytes <= max_fill_size and state is not writing
+     */
+    void fill(std::size_t num_bytes) {
+        auto keep_begin = pos - std::min(pos, max_history_size);
+        std::memmove(buffer.data(), buffer.data() + keep_begin, size - keep_begin);
+        size -= keep_begin;
+        pos -= keep_begin;
+
+        auto missing = num_bytes - (size - pos);
+        size += backend.read_some(buffer.data() + size, missing, buffer_size - size);
+        state = buffer_state::reading;
+    }
+
+    void load_slow(std::byte* target, std::size_t num_bytes) {
+        if (state == buffer_state::writing) {
+            flush();
+        }
+
+        if (state == buffer_state::idle && pending_seek != 0) {
+            auto skipped = static_cast<std::size_t>(pending_seek);
+            if (pending_seek > 0 && skipped <= max_history_size && num_bytes <= max_fill_size - skipped) {
+                // Read the skipped data into the buffer, so that seeking back to it stays cheap
+                pending_seek = 0;
+                fill(skipped + num_bytes);
+                pos = skipped;
+            } else {
+                backend.seek(pending_seek);
+                pending_seek = 0;
+            }
+        }
+
+        if (num_bytes <= max_fill_size) {
+            if (num_bytes > size - pos) {
+                fill(num_bytes);
+            }
+            std::memcpy(target, buffer.data() + pos, num_bytes);
+            pos += num_bytes;
+            return;
+        }
+
+        // Consume the rest of the buffer, then read the remainder directly from the backend
+        if (state == buffer_state::reading) {
+            auto available = size - pos;
+            std::memcpy(target, buffer.data() + pos, available);
+            target += available;
+            num_bytes -= available;
+        }
+        reset();
+        backend.read_some(target, num_bytes, num_bytes);
+    }
+
+    void store_slow(std::byte* source, std::size_t num_bytes) {
+        // Drop any read-ahead data or write pending data first
+        flush();
+
+        if (num_bytes >= buffer_size) {
+            backend.write(source, num_bytes);
+            return;
+        }
+
+        state = buffer_state::writing;
+        std::memcpy(buffer.data(), source, num_bytes);
+        pos = size = num_bytes;
+    }
+
+    // Amount of data retained before the cursor upon refill
+    static constexpr std::size_t max_history_size = buffer_size / 4;
+
+    // Largest amount of data requested from the backend through the buffer. Larger loads bypass it
+    static constexpr std::size_t max_fill_size = buffer_size - max_history_size;
+
+    runtime_storage& backend;
+    buffer_state state = buffer_state::idle;
+
+    // Cursor within the buffer
+    std::size_t pos = 0;
+
+    // Number of valid bytes in the buffer
+    std::size_t size = 0;
+
+    // Offset of the cursor relative to the backend position in idle state
+    std::ptrdiff_t pending_seek = 0;
+
+    std::array<std::byte, buffer_size> buffer;
 };
 
+namespace detail {
+
+// Type-erased abstraction for a runtime-provided backend
+using default_storage_backend = type_erased_storage;
+
 } // namespace detail
 
 } // namespace blob
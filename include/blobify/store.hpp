@@ -3,14 +3,20 @@
 
 #include "construction_policy.hpp"
 #include "exceptions.hpp"
+#include "memory_storage.hpp"
 #include "properties.hpp"
+#include "result.hpp"
 #include "storage_backend.hpp"
 
 #include "detail/is_array.hpp"
+#include "detail/is_vector.hpp"
 
 #include <boost/pfr/core.hpp>
 
+#include <algorithm>
 #include <cstddef>
+#include <iterator>
+#include <tuple>
 
 namespace blob {
 
@@ -21,6 +27,9 @@ constexpr void store(Storage&&, const Data& data, tag<ConstructionPolicy> = { })
 
 namespace detail {
 
+template<typename Storage, typename ConstructionPolicy, typename Data>
+constexpr void store_aggregate(Storage&, const Data&);
+
 // Store a single, plain data type element
 template<typename Representative, typename Storage>
 constexpr void store_element_representative(Storage& storage, Representative rep) {
@@ -30,14 +39,49 @@ constexpr void store_element_representative(Storage& storage, Representative rep
 template<auto member_props, typename Storage, typename ConstructionPolicy, typename ArrayType>
 constexpr void store_array(Storage&, const ArrayType&);
 
+/**
+ * Store count elementary values in their serialized endianness. Values that
+ * need byte-swapping are converted directly into contiguous storages, and
+ * converted in chunks for other storages to limit the number of storage
+ * accesses without requiring a temporary copy of the entire input.
+ */
+template<auto member_props, typename Storage, typename ElementType>
+void store_elements_bulk(Storage& storage, const ElementType* elements, std::size_t count) {
+    if constexpr (member_props->endianness == endian::native) {
+        transfer_in_chunks(storage, sizeof(ElementType), count, [&](std::size_t first, std::size_t num_elements) {
+            store_borrowed(storage, reinterpret_cast<const std::byte*>(elements + first), num_elements * sizeof(ElementType));
+        });
+    } else if constexpr (is_contiguous_storage_v<Storage>) {
+        // Bounds-checked storages may not have been checked yet, e.g. for elements following a variable-length member
+        auto&& target = checked_store_access(storage, sizeof(ElementType), count);
+        transfer_in_chunks(target, sizeof(ElementType), count, [&](std::size_t first, std::size_t num_elements) {
+            byteswap_copy_n(target.current, elements + first, num_elements);
+            // The data was stored in place, so advance the cursor directly rather than seeking past it
+            target.current += num_elements * sizeof(ElementType);
+        });
+    } else {
+        constexpr std::size_t chunk_size = 1024 / sizeof(ElementType);
+        alignas(ElementType) std::byte buffer[chunk_size * sizeof(ElementType)];
+        while (count) {
+            auto num_elements = std::min(count, chunk_size);
+            byteswap_copy_n(buffer, elements, num_elements);
+            storage.store(buffer, num_elements * sizeof(ElementType));
+            elements += num_elements;
+            count -= num_elements;
+        }
+    }
+}
+
 // Store a single element (possibly aggregate)
 template<auto member_props, typename Storage, typename ConstructionPolicy, typename Member>
 constexpr void store_element(Storage& storage, const Member& member) {
+    static_assert(!is_variable_length_v<Member>, "Variable-length elements may only be stored as members of an aggregate with a count member");
+
     if constexpr (detail::is_std_array_v<Member>) {
         // Optimized code path for collections of uniform type
         store_array<member_props, Storage, ConstructionPolicy>(storage, member);
     } else if constexpr (std::is_class_v<Member>) {
-        store<Storage&, ConstructionPolicy>(storage, member);
+        store_aggregate<Storage, ConstructionPolicy>(storage, member);
     } else {
         using representative_type = typename std::remove_reference_t<decltype(*member_props)>::representative_type;
         store_element_representative(storage, ConstructionPolicy::template encode<representative_type, Member, member_props->endianness>(member));
@@ -46,14 +90,146 @@ constexpr void store_element(Storage& storage, const Member& member) {
 
 template<auto member_props, typename Storage, typename ConstructionPolicy, typename ArrayType>
 constexpr void store_array(Storage& storage, const ArrayType& array) {
-    for (auto& element : array) {
-        store_element<member_props, Storage, ConstructionPolicy>(storage, element);
+    if constexpr (can_bulk_transfer_v<ConstructionPolicy, ArrayType, member_props>) {
+        // Serialized layout matches the in-memory layout, so store all elements at once
+        store_borrowed(storage, reinterpret_cast<const std::byte*>(array.data()), sizeof(array));
+    } else if constexpr (can_bulk_decode_v<ConstructionPolicy, typename ArrayType::value_type>) {
+        using ElementType = typename ArrayType::value_type;
+        constexpr auto num_bytes = std::tuple_size_v<ArrayType> * sizeof(ElementType);
+        // Small arrays are converted directly into contiguous storages, since
+        // the element-sized writes to a temporary buffer would stall the
+        // subsequent copy. Larger arrays are converted into a buffer, which
+        // unlike the storage memory is known not to alias the array.
+        constexpr bool convert_in_place = is_contiguous_storage_v<Storage> && num_bytes < 32;
+        if constexpr (member_props->endianness != endian::native && !convert_in_place && num_bytes <= 1024) {
+            // The array size is known statically, so convert it in one go rather than in chunks
+            alignas(ElementType) std::byte buffer[num_bytes];
+            byteswap_copy_n(buffer, array.data(), array.size());
+            storage.store(buffer, num_bytes);
+        } else {
+            store_elements_bulk<member_props>(storage, array.data(), array.size());
+        }
+    } else {
+        for (auto& element : array) {
+            store_element<member_props, Storage, ConstructionPolicy>(storage, element);
+        }
+    }
+}
+
+/**
+ * Store count elements from the given memory range, using a single storage
+ * access where possible
+ */
+template<auto member_props, typename Storage, typename ConstructionPolicy, typename ElementType>
+constexpr void store_elements(Storage& storage, const ElementType* elements, std::size_t count) {
+    if constexpr (can_bulk_transfer_v<ConstructionPolicy, ElementType, member_props>) {
+        // Elements are stored contiguously with their in-memory layout, so store them all at once
+        transfer_in_chunks(storage, sizeof(ElementType), count, [&](std::size_t first, std::size_t num_elements) {
+            store_borrowed(storage, reinterpret_cast<const std::byte*>(elements + first), num_elements * sizeof(ElementType));
+        });
+    } else if constexpr (can_bulk_decode_v<ConstructionPolicy, ElementType>) {
+        store_elements_bulk<member_props>(storage, elements, count);
+    } else {
+        access_in_chunks(storage, sizeof(ElementType), count, [&](std::size_t i) {
+            store_element<member_props, Storage, ConstructionPolicy>(storage, elements[i]);
+        });
+    }
+}
+
+/// Store the elements of a variable-length member
+template<auto member_props, typename Storage, typename ConstructionPolicy, typename Member>
+void store_variable_length(Storage& storage, const Member& member) {
+    using ElementType = array_element_t<Member>;
+    auto&& target = checked_store_access(storage, total_serialized_size<ElementType>(), member.size());
+    using TargetStorage = std::remove_reference_t<decltype(target)>;
+
+    if constexpr (std::is_same_v<ElementType, bool>) {
+        // std::vector<bool> doesn't provide access to its elements in memory
+        for (bool element : member) {
+            store_element<member_props, TargetStorage, ConstructionPolicy>(target, element);
+        }
+    } else {
+        store_elements<member_props, TargetStorage, ConstructionPolicy>(target, member.data(), member.size());
+    }
+}
+
+/// Encodes the bit-field member at Idx of Data into its position in the given (native-endian) word
+template<typename Data, std::size_t Idx, typename ConstructionPolicy, typename Word, typename Member>
+constexpr Word insert_bit_field(Word word, const Member& value) {
+    using representative_type = typename std::remove_reference_t<decltype(member_properties_for<Data, Idx>)>::representative_type;
+    using unsigned_type = std::make_unsigned_t<representative_type>;
+    constexpr auto& layout = layout_for<Data>.members[Idx];
+    constexpr auto mask = (layout.bit_width == 8 * sizeof(Word)) ? static_cast<Word>(~Word { 0 }) : static_cast<Word>((Word { 1 } << layout.bit_width) - 1);
+
+    auto representative = ConstructionPolicy::template encode<representative_type, Member, endian::native>(value);
+    auto bits = static_cast<Word>(static_cast<Word>(static_cast<unsigned_type>(representative)) & mask);
+    return static_cast<Word>(word | static_cast<Word>(bits << layout.bit_offset));
+}
+
+/// Store all bit-field members sharing the word of the member at FirstIdx with a single storage access
+template<typename Data, std::size_t FirstIdx, typename Storage, typename ConstructionPolicy>
+constexpr void store_bit_field_word(Storage& storage, const Data& data) {
+    constexpr auto& layout = layout_for<Data>.members[FirstIdx];
+    bit_field_word_t<layout.word_size> word = 0;
+    for_each_bit_field_in_word<Data, FirstIdx>([&](auto field_index) {
+        constexpr std::size_t Idx = decltype(field_index)::value;
+        word = insert_bit_field<Data, Idx, ConstructionPolicy>(word, boost::pfr::get<Idx>(data));
+    });
+    if constexpr (layout.endianness != endian::native) {
+        word = byteswap(word);
+    }
+    store_element_representative(storage, word);
+}
+
+/**
+ * Value to store for the member at CountIdx: If it is the count member of any
+ * variable-length member, this is the number of elements of the first such member
+ */
+template<std::size_t CountIdx, typename Data>
+auto element_count_for_store(const Data& data) {
+    using CountType = boost::pfr::tuple_element_t<CountIdx, Data>;
+    constexpr auto counted_index = counted_member_for<Data, CountIdx>();
+    if constexpr (counted_index == static_cast<std::size_t>(-1)) {
+        return boost::pfr::get<CountIdx>(data);
+    } else {
+        auto size = boost::pfr::get<counted_index>(data).size();
+        auto count = static_cast<CountType>(size);
+        if (count < 0 || static_cast<std::size_t>(count) != size) {
+            throw invalid_length_exception { size };
+        }
+        return count;
     }
 }
 
 template<typename Storage, typename ConstructionPolicy, typename Data, std::size_t... Idxs>
 constexpr void store_helper_t(Storage& storage, const Data& data, std::index_sequence<Idxs...>) {
-    (store_element<&member_properties_for<Data, Idxs>, Storage, ConstructionPolicy>(storage, boost::pfr::get<Idxs>(data)), ...);
+    if constexpr (is_fixed_size<Data>() && !layout_for<Data>.has_bit_fields) {
+        (store_element<&member_properties_for<Data, Idxs>, Storage, ConstructionPolicy>(storage, boost::pfr::get<Idxs>(data)), ...);
+    } else {
+        auto store_member = [&](auto index_constant) {
+            constexpr std::size_t Idx = decltype(index_constant)::value;
+            constexpr auto member_props = &member_properties_for<Data, Idx>;
+            constexpr auto& layout = layout_for<Data>.members[Idx];
+            if constexpr (layout.kind == member_kind::variable_length) {
+                // All variable-length members sharing a count member must have the same number of elements
+                constexpr auto counted_index = counted_member_for<Data, layout.count_member_index>();
+                if constexpr (counted_index != Idx) {
+                    if (boost::pfr::get<Idx>(data).size() != boost::pfr::get<counted_index>(data).size()) {
+                        throw invalid_length_exception { boost::pfr::get<Idx>(data).size() };
+                    }
+                }
+                store_variable_length<member_props, Storage, ConstructionPolicy>(storage, boost::pfr::get<Idx>(data));
+            } else if constexpr (layout.kind == member_kind::bit_field) {
+                // All bit-fields of a word are stored along with the first one
+                if constexpr (layout.bit_offset == 0) {
+                    store_bit_field_word<Data, Idx, Storage, ConstructionPolicy>(storage, data);
+                }
+            } else {
+                store_element<member_props, Storage, ConstructionPolicy>(storage, element_count_for_store<Idx>(data));
+            }
+        };
+        (store_member(std::integral_constant<std::size_t, Idxs> { }), ...);
+    }
 }
 
 /**
@@ -92,23 +268,102 @@ constexpr void lens_store_to_offset(Storage& storage, std::size_t offset, const
         } seeker(storage, offset);
 
         // This is the actual object requested by the user, so use the standard load_element code path to fetch it
+        static_assert(!is_bit_field_member<Data, member_index>(), "Bit-field members share their word with other members and hence can't be stored individually");
         constexpr auto& member_properties = detail::member_properties_for<Data, member_index>;
         detail::store_element<&member_properties, Storage, ConstructionPolicy>(storage, value);
     }
 }
 
+/// Store an aggregate as part of an enclosing top-level operation
+template<typename Storage, typename ConstructionPolicy, typename Data>
+constexpr void store_aggregate(Storage& storage, const Data& data) {
+    generic_validate<Data>();
+
+    auto&& target = checked_store_access_for<Data>(storage);
+    using TargetStorage = std::remove_reference_t<decltype(target)>;
+
+    if constexpr (can_bulk_transfer_v<ConstructionPolicy, Data, &properties_for<Data>>) {
+        // Serialized layout matches the in-memory layout, so store the entire aggregate at once
+        store_borrowed(target, reinterpret_cast<const std::byte*>(&data), sizeof(data));
+    } else {
+        constexpr auto index_sequence = std::make_index_sequence<boost::pfr::tuple_size_v<Data>> { };
+        store_helper_t<TargetStorage, ConstructionPolicy>(target, data, index_sequence);
+    }
+}
+
+/**
+ * Stores the given values to the members of a lens_batch in a single forward
+ * pass, seeking back to the beginning of the blob afterwards
+ */
+template<typename Data, typename ConstructionPolicy, typename Batch, typename Storage, typename Values, std::size_t... Positions>
+void lens_store_batch(Storage& storage, const Values& values, std::index_sequence<Positions...>) {
+    lens_rewinder<Storage> rewinder { storage };
+
+    auto store_access = [&](auto position) {
+        constexpr std::size_t Pos = decltype(position)::value;
+        constexpr std::size_t Access = Batch::order[Pos];
+        constexpr std::size_t Idx = Batch::member_indices[Access];
+        static_assert(!is_bit_field_member<Data, Idx>(), "Bit-field members share their word with other members and hence can't be stored individually");
+
+        constexpr auto skipped_bytes = Batch::offsets[Access] - Batch::end_before(Pos);
+        if constexpr (skipped_bytes != 0) {
+            storage.seek(skipped_bytes);
+        }
+        rewinder.position = Batch::offsets[Access] + Batch::sizes[Access];
+        store_element<&member_properties_for<Data, Idx>, Storage, ConstructionPolicy>(storage, std::get<Access>(values));
+    };
+    (store_access(std::integral_constant<std::size_t, Positions> { }), ...);
+}
+
 } // namespace detail
 
 template<typename Storage,
          typename ConstructionPolicy,
          typename Data>
 constexpr void store(Storage&& storage, const Data& data, tag<ConstructionPolicy>) {
-    detail::generic_validate<Data>();
-
     // NOTE: rvalue reference Storage inputs are forwarded as lvalue references here,
     //       since the Storage will usually carry state that we want to keep
-    constexpr auto index_sequence = std::make_index_sequence<boost::pfr::tuple_size_v<Data>> { };
-    detail::store_helper_t<Storage, ConstructionPolicy>(storage, data, index_sequence);
+    using StorageType = std::remove_reference_t<Storage>;
+    detail::borrow_scope<StorageType> scope { storage };
+    detail::store_aggregate<StorageType, ConstructionPolicy>(storage, data);
+    scope.release();
+}
+
+/**
+ * Variant of store() that reports failures through its return value rather
+ * than by throwing.
+ *
+ * For bounds-checked storages providing remaining(), the bounds are checked
+ * up-front without involving exceptions. Other failures are reported by the
+ * storage or by store() by throwing, and the following exceptions are caught
+ * and converted:
+ * - storage_exhausted_exception to error_kind::storage_exhausted
+ * - invalid_length_exception (for variable-length members) to error_kind::invalid_length
+ * - storage_io_exception (e.g. for read-only mmap_storage or write errors in fd_ostream_storage) to error_kind::storage_io
+ *
+ * Any other exceptions, such as std::bad_alloc or exceptions thrown by a
+ * custom construction policy or by an underlying std::ostream, propagate to
+ * the caller.
+ *
+ * @note On failure, data may have been partially written to storages that aren't bounds-checked
+ */
+template<typename Storage,
+         typename ConstructionPolicy = detail::default_construction_policy,
+         typename Data>
+result<void> try_store(Storage&& storage, const Data& data, tag<ConstructionPolicy> tag = { }) {
+    if (!detail::can_store_access(storage, detail::total_serialized_size<Data>())) {
+        return error_info { error_kind::storage_exhausted };
+    }
+    try {
+        store(storage, data, tag);
+    } catch (const storage_exhausted_exception&) {
+        return error_info { error_kind::storage_exhausted };
+    } catch (const invalid_length_exception& error) {
+        return error_info { error_kind::invalid_length, 0, 0, 0, static_cast<std::int64_t>(error.length) };
+    } catch (const storage_io_exception& error) {
+        return error_info { error_kind::storage_io, 0, 0, 0, error.error_code };
+    }
+    return { };
 }
 
 /**
@@ -122,9 +377,19 @@ template<auto Properties,
          template<typename> class Container,
          typename Data>
 constexpr void store_many_explicit(Storage&& storage, const Container<Data>& data, tag<ConstructionPolicy> = {}) {
-    for (auto& element : data) {
-        detail::store_element<Properties, std::remove_reference_t<Storage>, ConstructionPolicy>(storage, element);
+    detail::borrow_scope<std::remove_reference_t<Storage>> scope { storage };
+    auto&& target = detail::checked_store_access_for<Data>(storage, std::size(data));
+    using TargetStorage = std::remove_reference_t<decltype(target)>;
+
+    if constexpr (detail::is_std_vector_v<Container<Data>> && !std::is_same_v<Data, bool>) {
+        detail::store_elements<Properties, TargetStorage, ConstructionPolicy>(target, data.data(), data.size());
+    } else {
+        auto element = std::begin(data);
+        detail::access_in_chunks(target, detail::total_serialized_size<Data>(), std::size(data), [&](std::size_t) {
+            detail::store_element<Properties, TargetStorage, ConstructionPolicy>(target, *element++);
+        });
     }
+    scope.release();
 }
 
 template<typename Storage,
@@ -150,11 +415,50 @@ constexpr void lens_store(Storage&& storage, const Value& value,
     detail::generic_validate<Data>();
     static_assert(detail::is_valid_pmd_chain_v<Data, decltype(PointerToMember1), decltype(PointersToMember)...>,
                   "Given list of pointers-to-member does not form a valid member lookup chain");
+    static_assert(detail::is_fixed_size<Data>(), "Member offsets of aggregates with variable-length members are not known statically");
 
     using SpecificValueType = detail::pointed_member_type<Data, PointerToMember1, PointersToMember...>;
 
     // Now that we've asserted that the pointer-to-member chain is valid, defer to lens_store_to_offset (which uses a more specific Value parameter type)
-    detail::lens_store_to_offset<SpecificValueType, ConstructionPolicy, PointerToMember1, PointersToMember...>(storage, 0, value);
+    detail::borrow_scope<std::remove_reference_t<Storage>> scope { storage };
+    auto&& target = detail::checked_store_access(storage, detail::total_serialized_size<Data>());
+    detail::lens_store_to_offset<SpecificValueType, ConstructionPolicy, PointerToMember1, PointersToMember...>(target, 0, value);
+    scope.release();
+}
+
+/**
+ * Stores several direct members of the parent of PointerToMember1, like a
+ * sequence of lens_store calls.
+ *
+ * The members are stored in the order of their serialized offsets within a
+ * single forward pass, after which the storage is moved back to the beginning
+ * of the blob.
+ *
+ * @param values Values of the members, in the order of the given pointers-to-member
+ */
+template<auto PointerToMember1,
+         auto... PointersToMember,
+         typename Storage,
+         typename ConstructionPolicy = detail::default_construction_policy>
+void lens_store_many(Storage&& storage,
+                     const typename detail::pmd_traits_t<PointerToMember1>::member_type& value1,
+                     const typename detail::pmd_traits_t<PointersToMember>::member_type&... values,
+                     tag<ConstructionPolicy> = { }) {
+    using Data = typename detail::pmd_traits_t<PointerToMember1>::parent_type;
+    detail::generic_validate<Data>();
+    static_assert((std::is_same_v<typename detail::pmd_traits_t<PointersToMember>::parent_type, Data> && ...),
+                  "All pointers-to-member must refer to members of the same aggregate");
+    static_assert(detail::is_fixed_size<Data>(), "Member offsets of aggregates with variable-length members are not known statically");
+
+    using Batch = detail::lens_batch<Data, PointerToMember1, PointersToMember...>;
+    static_assert(Batch::is_disjoint(), "Members may not be stored more than once");
+
+    detail::borrow_scope<std::remove_reference_t<Storage>> scope { storage };
+    auto&& target = detail::checked_store_access(storage, detail::total_serialized_size<Data>());
+    using TargetStorage = std::remove_reference_t<decltype(target)>;
+    detail::lens_store_batch<Data, ConstructionPolicy, Batch, TargetStorage>(target, std::forward_as_tuple(value1, values...),
+                                                                           std::make_index_sequence<Batch::size> { });
+    scope.release();
 }
 
 } // namespace blob
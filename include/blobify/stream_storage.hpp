@@ -1,7 +1,10 @@
 #ifndef BLOBIFY_STREAM_STORAGE_HPP
 #define BLOBIFY_STREAM_STORAGE_HPP
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include "exceptions.hpp"
 #include "storage_backend.hpp"
 
@@ -22,6 +25,20 @@ struct istream_storage {
             throw storage_exhausted_exception { };
         }
     }
+
+    /**
+     * Reads up to max_bytes bytes, stopping early at the end of the stream
+     * @return Number of bytes read
+     */
+    std::size_t read_some(std::byte* target, std::size_t max_bytes) {
+        stream.read(reinterpret_cast<char*>(target), max_bytes);
+        if (stream.eof() && !stream.bad()) {
+            stream.clear();
+        } else if (!stream) {
+            throw storage_exhausted_exception { };
+        }
+        return static_cast<std::size_t>(stream.gcount());
+    }
 };
 
 struct ostream_storage {
@@ -45,7 +62,7 @@ struct ostream_storage {
  * Storage backend for std::istream.
  *
  * Note this translates each member-load to an fstream read, so for
- * optimal performance you should proxy this with a memory_storage.
+ * optimal performance you should use buffered_istream_storage instead.
  */
 struct istream_storage : detail::istream_storage {
     void seek(std::ptrdiff_t num_bytes) {
@@ -57,7 +74,7 @@ struct istream_storage : detail::istream_storage {
  * Storage backend for std::ostream.
  *
  * Note this translates each member-store to an fstream write, so for
- * optimal performance you should proxy this with a memory_storage.
+ * optimal performance you should use buffered_ostream_storage instead.
  */
 struct ostream_storage : detail::ostream_storage {
     void seek(std::ptrdiff_t num_bytes) {
@@ -65,6 +82,178 @@ struct ostream_storage : detail::ostream_storage {
     }
 };
 
+/**
+ * Storage backend for std::istream that reads data in blocks of a fixed size.
+ *
+ * Small loads are served from an internal buffer, whereas loads of at least
+ * block_size bytes bypass it. Seeks within the buffered range don't access the
+ * underlying stream.
+ */
+class buffered_istream_storage {
+    std::istream& stream;
+    std::unique_ptr<std::byte[]> buffer;
+    std::size_t block_size;
+
+    // Read cursor within the buffer
+    std::size_t buffer_pos = 0;
+
+    // Number of valid bytes in the buffer. The stream position corresponds to the end of this range
+    std::size_t buffer_size = 0;
+
+    void refill() {
+        stream.read(reinterpret_cast<char*>(buffer.get()), block_size);
+        buffer_pos = 0;
+        buffer_size = static_cast<std::size_t>(stream.gcount());
+        if (stream.eof() && !stream.bad()) {
+            // Reaching the end of the stream is fine as long as the buffered data suffices.
+            // Clear the error state so that later seeks are still possible
+            stream.clear();
+        } else if (!stream) {
+            throw storage_exhausted_exception { };
+        }
+    }
+
+public:
+    static constexpr std::size_t default_block_size = 4096;
+
+    buffered_istream_storage(std::istream& stream, std::size_t block_size = default_block_size)
+        : stream(stream), buffer(std::make_unique<std::byte[]>(block_size)), block_size(block_size) {
+    }
+
+    void seek(std::ptrdiff_t num_bytes) {
+        auto target = static_cast<std::ptrdiff_t>(buffer_pos) + num_bytes;
+        if (target >= 0 && target <= static_cast<std::ptrdiff_t>(buffer_size)) {
+            buffer_pos = static_cast<std::size_t>(target);
+            return;
+        }
+
+        // Drop the buffer and move the stream to the new position instead
+        auto stream_offset = target - static_cast<std::ptrdiff_t>(buffer_size);
+        buffer_pos = buffer_size = 0;
+        if (stream_offset > 0) {
+            stream.ignore(stream_offset);
+        } else {
+            stream.seekg(stream_offset, std::ios::cur);
+        }
+    }
+
+    void load(std::byte* target, std::size_t num_bytes) {
+        auto available = buffer_size - buffer_pos;
+        if (num_bytes <= available) {
+            std::memcpy(target, buffer.get() + buffer_pos, num_bytes);
+            buffer_pos += num_bytes;
+            return;
+        }
+
+        // Consume the rest of the buffer, then continue with the stream
+        std::memcpy(target, buffer.get() + buffer_pos, available);
+        target += available;
+        num_bytes -= available;
+        buffer_pos = buffer_size = 0;
+
+        if (num_bytes >= block_size) {
+            stream.read(reinterpret_cast<char*>(target), num_bytes);
+            if (!stream) {
+                throw storage_exhausted_exception { };
+            }
+            return;
+        }
+
+        refill();
+        if (buffer_size < num_bytes) {
+            throw storage_exhausted_exception { };
+        }
+        std::memcpy(target, buffer.get(), num_bytes);
+        buffer_pos = num_bytes;
+    }
+};
+
+/**
+ * Storage backend for std::ostream that writes data in blocks of a fixed size.
+ *
+ * Small stores are collected in an internal buffer, whereas stores of at least
+ * block_size bytes bypass it. Seeks within the buffered range don't access the
+ * underlying stream.
+ *
+ * Buffered data is written to the stream upon destruction. Call flush()
+ * explicitly to be notified of errors.
+ */
+class buffered_ostream_storage {
+    std::ostream& stream;
+    std::unique_ptr<std::byte[]> buffer;
+    std::size_t block_size;
+
+    // Write cursor within the buffer
+    std::size_t buffer_pos = 0;
+
+    // Number of pending bytes in the buffer. The stream position corresponds to the beginning of the buffer
+    std::size_t buffer_size = 0;
+
+public:
+    static constexpr std::size_t default_block_size = 4096;
+
+    buffered_ostream_storage(std::ostream& stream, std::size_t block_size = default_block_size)
+        : stream(stream), buffer(std::make_unique<std::byte[]>(block_size)), block_size(block_size) {
+    }
+
+    ~buffered_ostream_storage() {
+        try {
+            flush();
+        } catch (...) {
+            // Errors can't be reported from the destructor. This includes
+            // std::ios_base::failure thrown by streams with exceptions enabled
+        }
+    }
+
+    /**
+     * Writes all pending data to the underlying stream
+     * @post The stream position matches the write cursor
+     */
+    void flush() {
+        if (buffer_size == 0) {
+            return;
+        }
+
+        stream.write(reinterpret_cast<char*>(buffer.get()), buffer_size);
+        if (buffer_pos != buffer_size) {
+            stream.seekp(static_cast<std::ptrdiff_t>(buffer_pos) - static_cast<std::ptrdiff_t>(buffer_size), std::ios::cur);
+        }
+        buffer_pos = buffer_size = 0;
+        if (!stream) {
+            throw storage_exhausted_exception { };
+        }
+    }
+
+    void seek(std::ptrdiff_t num_bytes) {
+        auto target = static_cast<std::ptrdiff_t>(buffer_pos) + num_bytes;
+        if (target >= 0 && target <= static_cast<std::ptrdiff_t>(buffer_size)) {
+            buffer_pos = static_cast<std::size_t>(target);
+            return;
+        }
+
+        // NOTE: flush() moves the stream position to the current write cursor
+        flush();
+        stream.seekp(num_bytes, std::ios::cur);
+    }
+
+    void store(std::byte* source, std::size_t num_bytes) {
+        if (num_bytes > block_size - buffer_pos) {
+            flush();
+            if (num_bytes >= block_size) {
+                stream.write(reinterpret_cast<char*>(source), num_bytes);
+                if (!stream) {
+                    throw storage_exhausted_exception { };
+                }
+                return;
+            }
+        }
+
+        std::memcpy(buffer.get() + buffer_pos, source, num_bytes);
+        buffer_pos += num_bytes;
+        buffer_size = std::max(buffer_size, buffer_pos);
+    }
+};
+
 } // namespace blob
 
 #endif // BLOBIFY_STREAM_STORAGE_HPP
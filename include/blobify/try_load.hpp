@@ -0,0 +1,409 @@
+#ifndef BLOBIFY_TRY_LOAD_HPP
+#define BLOBIFY_TRY_LOAD_HPP
+
+#include "load.hpp"
+#include "memory_storage.hpp"
+#include "result.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace blob {
+
+namespace detail {
+
+/// Checks if loading an element with the given properties involves any runtime validation
+template<typename Member, auto member_props>
+constexpr bool has_runtime_checks() {
+    if constexpr (is_std_array_v<Member>) {
+        return member_props->expected_value || has_runtime_checks<typename Member::value_type, member_props>();
+    } else if constexpr (std::is_class_v<Member>) {
+        return layout_for<Member>.has_validation;
+    } else {
+        return has_element_expected_value<member_props> || member_props->validate_enum || member_props->validate_enum_bounds;
+    }
+}
+
+template<typename Value>
+constexpr std::int64_t error_value(const Value& value) {
+    if constexpr (std::is_enum_v<Value>) {
+        return static_cast<std::int64_t>(static_cast<std::underlying_type_t<Value>>(value));
+    } else if constexpr (std::is_integral_v<Value>) {
+        return static_cast<std::int64_t>(value);
+    } else if constexpr (std::is_floating_point_v<Value>) {
+        // Report the bit pattern so that values such as NaN can be told apart
+        return static_cast<std::int64_t>(bit_cast<decltype(select_representative<Value>())>(value));
+    } else {
+        // Aggregates can't be described by a single integer
+        return 0;
+    }
+}
+
+/// Decodes a single elementary value from its serialized bytes
+template<typename Member, auto member_props, typename ConstructionPolicy>
+Member decode_element(const std::byte* data) {
+    using representative_type = typename std::remove_reference_t<decltype(*member_props)>::representative_type;
+    representative_type representative;
+    std::memcpy(&representative, data, sizeof(representative));
+    return ConstructionPolicy::template decode<Member, representative_type, member_props->endianness>(representative);
+}
+
+/// Decodes the bit-field member at Idx of Data from the serialized bytes of its word
+template<typename Data, std::size_t Idx, typename ConstructionPolicy>
+auto decode_bit_field(const std::byte* word_data) {
+    auto source = const_cast<std::byte*>(word_data);
+    memory_storage storage { source, source, source + layout_for<Data>.members[Idx].word_size };
+    return extract_bit_field<Data, Idx, ConstructionPolicy>(load_bit_field_word<Data, Idx>(storage));
+}
+
+template<typename Member, auto member_props, typename ConstructionPolicy>
+bool is_valid_serialized(const std::byte* data);
+
+template<typename Data, std::size_t Idx, typename ConstructionPolicy>
+bool is_valid_serialized_member(const std::byte* data) {
+    using Member = boost::pfr::tuple_element_t<Idx, Data>;
+    constexpr auto member_props = &member_properties_for<Data, Idx>;
+    constexpr auto& layout = layout_for<Data>.members[Idx];
+    if constexpr (!layout.has_validation) {
+        return true;
+    } else if constexpr (layout.kind == member_kind::bit_field) {
+        return is_valid_element<member_props>(decode_bit_field<Data, Idx, ConstructionPolicy>(data));
+    } else {
+        return is_valid_serialized<Member, member_props, ConstructionPolicy>(data);
+    }
+}
+
+template<typename Data, typename ConstructionPolicy, std::size_t... Idxs>
+bool are_members_valid_serialized(const std::byte* data, std::index_sequence<Idxs...>) {
+    constexpr auto& layout = layout_for<Data>;
+    return (is_valid_serialized_member<Data, Idxs, ConstructionPolicy>(data + layout.members[Idxs].offset) & ...);
+}
+
+/**
+ * Checks if the serialized bytes of an element pass all validation checks.
+ * Contrary to check_element, this does not report the reason of failure.
+ * All checks are evaluated without early exit so that the compiler can
+ * vectorize them.
+ */
+template<typename Member, auto member_props, typename ConstructionPolicy>
+bool is_valid_serialized(const std::byte* data) {
+    if constexpr (!has_runtime_checks<Member, member_props>()) {
+        return true;
+    } else if constexpr (is_std_array_v<Member>) {
+        using ElementType = typename Member::value_type;
+        constexpr auto element_size = total_serialized_size<ElementType>();
+        bool valid = true;
+        if constexpr (std::is_class_v<ElementType>) {
+            for (std::size_t i = 0; i < std::tuple_size_v<Member>; ++i) {
+                valid &= is_valid_serialized<ElementType, member_props, ConstructionPolicy>(data + i * element_size);
+            }
+        } else if constexpr (has_runtime_checks<ElementType, member_props>()) {
+            // NOTE: Accumulating in an integer of the element size rather than in a bool helps vectorization
+            std::make_unsigned_t<decltype(select_representative<ElementType>())> invalid = 0;
+            for (std::size_t i = 0; i < std::tuple_size_v<Member>; ++i) {
+                invalid |= !is_valid_element<member_props>(decode_element<ElementType, member_props, ConstructionPolicy>(data + i * element_size));
+            }
+            valid = !invalid;
+        }
+        if constexpr (member_props->expected_value.has_value()) {
+            if constexpr (std::is_class_v<ElementType>) {
+                // Aggregates may only be decoded if they are valid
+                auto source = const_cast<std::byte*>(data);
+                memory_storage storage { source, source, source + std::tuple_size_v<Member> * element_size };
+                for (std::size_t i = 0; valid && i < std::tuple_size_v<Member>; ++i) {
+                    valid = (load_element<ElementType, member_props, memory_storage, ConstructionPolicy>(storage) == (*member_props->expected_value)[i]);
+                }
+            } else {
+                for (std::size_t i = 0; i < std::tuple_size_v<Member>; ++i) {
+                    valid &= (decode_element<ElementType, member_props, ConstructionPolicy>(data + i * element_size) == (*member_props->expected_value)[i]);
+                }
+            }
+        }
+        return valid;
+    } else if constexpr (std::is_class_v<Member>) {
+        return are_members_valid_serialized<Member, ConstructionPolicy>(data, std::make_index_sequence<boost::pfr::tuple_size_v<Member>> { });
+    } else {
+        return is_valid_element<member_props>(decode_element<Member, member_props, ConstructionPolicy>(data));
+    }
+}
+
+/**
+ * Checks an elementary value decoded from offset against the validation checks of member_props
+ * @return true if the value is valid. Otherwise, error describes the first failing check
+ */
+template<auto member_props, typename Member>
+bool check_value(const Member& value, std::size_t offset, std::size_t member_index, error_info& error) {
+    if (is_valid_element<member_props>(value)) {
+        return true;
+    }
+
+    if constexpr (has_element_expected_value<member_props>) {
+        if (!(value == *member_props->expected_value)) {
+            error = { error_kind::unexpected_value, member_index, offset, error_value(*member_props->expected_value), error_value(value) };
+            return false;
+        }
+    }
+    error = { error_kind::invalid_enum_value, member_index, offset, 0, error_value(value) };
+    return false;
+}
+
+template<typename Member, auto member_props, typename ConstructionPolicy>
+bool check_element(const std::byte* data, std::size_t offset, std::size_t member_index, error_info& error);
+
+/// check_element for the member at Idx of Data. For bit-field members, offset refers to their word
+template<typename Data, std::size_t Idx, typename ConstructionPolicy>
+bool check_member(const std::byte* data, std::size_t offset, error_info& error) {
+    using Member = boost::pfr::tuple_element_t<Idx, Data>;
+    constexpr auto member_props = &member_properties_for<Data, Idx>;
+    constexpr auto& layout = layout_for<Data>.members[Idx];
+    if constexpr (!layout.has_validation) {
+        return true;
+    } else if constexpr (layout.kind == member_kind::bit_field) {
+        return check_value<member_props>(decode_bit_field<Data, Idx, ConstructionPolicy>(data), offset, Idx, error);
+    } else {
+        return check_element<Member, member_props, ConstructionPolicy>(data, offset, Idx, error);
+    }
+}
+
+template<typename Data, typename ConstructionPolicy, std::size_t... Idxs>
+bool check_members(const std::byte* data, std::size_t offset, error_info& error, std::index_sequence<Idxs...>) {
+    constexpr auto& layout = layout_for<Data>;
+    return (check_member<Data, Idxs, ConstructionPolicy>(data + layout.members[Idxs].offset, offset + layout.members[Idxs].offset, error) && ...);
+}
+
+/**
+ * Runs the validation checks of load_element directly on the serialized
+ * bytes of an element. Only validated members are decoded.
+ *
+ * @param offset Offset of data from the beginning of the accessed data, used for error reporting
+ * @param member_index Index of the element in its parent aggregate, used for error reporting
+ * @return true if the element is valid. Otherwise, error describes the first failing check
+ */
+template<typename Member, auto member_props, typename ConstructionPolicy>
+bool check_element(const std::byte* data, std::size_t offset, std::size_t member_index, error_info& error) {
+    if constexpr (!has_runtime_checks<Member, member_props>()) {
+        return true;
+    } else if constexpr (is_std_array_v<Member>) {
+        using ElementType = typename Member::value_type;
+        constexpr auto element_size = total_serialized_size<ElementType>();
+        if constexpr (has_runtime_checks<ElementType, member_props>()) {
+            for (std::size_t i = 0; i < std::tuple_size_v<Member>; ++i) {
+                if (!check_element<ElementType, member_props, ConstructionPolicy>(data + i * element_size, offset + i * element_size, member_index, error)) {
+                    return false;
+                }
+            }
+        }
+        if constexpr (member_props->expected_value.has_value()) {
+            // Compare elementwise to report the first mismatch. The elements are valid at this point, so this doesn't throw
+            auto source = const_cast<std::byte*>(data);
+            memory_storage storage { source, source, source + std::tuple_size_v<Member> * element_size };
+            for (std::size_t i = 0; i < std::tuple_size_v<Member>; ++i) {
+                auto element = load_element<ElementType, member_props, memory_storage, ConstructionPolicy>(storage);
+                if (!(element == (*member_props->expected_value)[i])) {
+                    error = { error_kind::unexpected_value, member_index, offset + i * element_size,
+                              error_value((*member_props->expected_value)[i]), error_value(element) };
+                    return false;
+                }
+            }
+        }
+        return true;
+    } else if constexpr (std::is_class_v<Member>) {
+        generic_validate<Member>();
+        return check_members<Member, ConstructionPolicy>(data, offset, error, std::make_index_sequence<boost::pfr::tuple_size_v<Member>> { });
+    } else {
+        return check_value<member_props>(decode_element<Member, member_props, ConstructionPolicy>(data), offset, member_index, error);
+    }
+}
+
+/**
+ * Checks a serialized Data record. See check_element.
+ * The offending member is only searched for if the record turns out to be invalid.
+ */
+template<typename Data, typename ConstructionPolicy>
+bool check_record(const std::byte* data, std::size_t offset, error_info& error) {
+    generic_validate<Data>();
+    if (is_valid_serialized<Data, &properties_for<Data>, ConstructionPolicy>(data)) {
+        return true;
+    }
+    return check_element<Data, &properties_for<Data>, ConstructionPolicy>(data, offset, 0, error);
+}
+
+/**
+ * Loads a single record from a storage previously prepared using checked_access.
+ * The record is checked once and then decoded without repeating the checks.
+ */
+template<typename Data, typename Storage, typename ConstructionPolicy>
+result<Data> try_load_record(Storage& storage, std::size_t offset) {
+    constexpr auto size = total_serialized_size<Data>();
+    error_info error { };
+    if constexpr (std::is_base_of_v<memory_storage, Storage>) {
+        // Check the record in place
+        if (!check_record<Data, ConstructionPolicy>(storage.current, offset, error)) {
+            storage.current += size;
+            return error;
+        }
+        return do_load<Data, Storage, prevalidated_policy<ConstructionPolicy>>(storage, {});
+    } else {
+        // Read the record once, then check and decode it from memory
+        std::array<std::byte, size> buffer;
+        if (!try_read(storage, buffer.data(), size)) {
+            return error_info { error_kind::storage_exhausted, 0, offset };
+        }
+        if (!check_record<Data, ConstructionPolicy>(buffer.data(), offset, error)) {
+            return error;
+        }
+        memory_storage source { buffer.data(), buffer.data(), buffer.data() + size };
+        return do_load<Data, memory_storage, prevalidated_policy<ConstructionPolicy>>(source, {});
+    }
+}
+
+} // namespace detail
+
+/**
+ * Variant of load() that reports failures through its return value rather
+ * than by throwing.
+ *
+ * The same validation checks as for load() are performed, but they are
+ * applied directly to the serialized bytes before decoding, so no exceptions
+ * are involved in reporting invalid data. Storage exhaustion is reported
+ * without exceptions for bounds-checked storages providing remaining() and
+ * for storages providing read_some(). For other storages, it is reported by
+ * catching storage_exhausted_exception.
+ *
+ * @post On success, advances the input stream by the serialized size of Data
+ * @post If the data is invalid, the input stream is still advanced past the offending record
+ */
+template<typename Data,
+         typename Storage,
+         typename ConstructionPolicy = detail::default_construction_policy>
+result<Data> try_load(Storage&& storage, tag<ConstructionPolicy> = { }) {
+    static_assert(detail::has_deducible_properties<Data>, "Data properties are not implicitly deducible");
+    static_assert(detail::is_fixed_size<Data>(), "Non-throwing loading is not supported for variable-length data");
+    constexpr auto size = detail::total_serialized_size<Data>();
+    if (!detail::can_access(storage, size)) {
+        return error_info { error_kind::storage_exhausted };
+    }
+    auto&& source = detail::checked_access(storage, size);
+    return detail::try_load_record<Data, std::remove_reference_t<decltype(source)>, ConstructionPolicy>(source, 0);
+}
+
+/**
+ * Variant of load_many() that reports failures through its return value
+ * rather than by throwing. See try_load for details.
+ *
+ * Byte offsets in the reported error are relative to the first element.
+ *
+ * @post If an element is invalid, the input stream is advanced past the offending element
+ */
+template<typename ContainerData,
+         typename Storage,
+         typename ConstructionPolicy = detail::default_construction_policy>
+result<ContainerData> try_load_many(Storage&& storage, std::size_t count, tag<ConstructionPolicy> = {}) {
+    using Data = typename ContainerData::value_type;
+    static_assert(detail::has_deducible_properties<Data>, "Data properties are not implicitly deducible");
+    static_assert(detail::is_fixed_size<Data>(), "Non-throwing loading is not supported for variable-length data");
+    constexpr auto size = detail::total_serialized_size<Data>();
+    if (!detail::can_access(storage, size, count)) {
+        return error_info { error_kind::storage_exhausted };
+    }
+    auto&& source = detail::checked_access(storage, size, count);
+    using StorageType = std::remove_reference_t<decltype(source)>;
+
+    if constexpr (std::is_base_of_v<memory_storage, StorageType>) {
+        // Check all elements in place, then decode them through the bulk
+        // loading code path without repeating the checks
+        error_info error { };
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!detail::check_record<Data, ConstructionPolicy>(source.current + i * size, i * size, error)) {
+                source.current += (i + 1) * size;
+                return error;
+            }
+        }
+        return load_many<ContainerData>(source, count, tag<detail::prevalidated_policy<ConstructionPolicy>> { });
+    } else {
+        ContainerData container;
+        container.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            auto element = detail::try_load_record<Data, StorageType, ConstructionPolicy>(source, i * size);
+            if (!element) {
+                return element.error();
+            }
+            container.push_back(std::move(*element));
+        }
+        return container;
+    }
+}
+
+/**
+ * Variant of lens_load() that reports failures through its return value
+ * rather than by throwing. See try_load for details.
+ *
+ * Byte offsets in the reported error are relative to the beginning of the
+ * parent of PointerToMember1.
+ *
+ * @post On success, the storage is at the beginning of the serialized blob as for lens_load
+ */
+template<auto PointerToMember1,
+         auto... PointersToMember,
+         typename Storage,
+         typename ConstructionPolicy = detail::default_construction_policy
+         >
+auto try_lens_load(Storage&& storage, tag<ConstructionPolicy> = { }) {
+    using Data = typename detail::pmd_traits_t<PointerToMember1>::parent_type;
+    detail::generic_validate<Data>();
+    static_assert(detail::is_valid_pmd_chain_v<Data, decltype(PointerToMember1), decltype(PointersToMember)...>,
+                  "Given list of pointers-to-member does not form a valid member lookup chain");
+    static_assert(detail::is_fixed_size<Data>(), "Member offsets of aggregates with variable-length members are not known statically");
+
+    using target = detail::lens_target<PointerToMember1, PointersToMember...>;
+    using MemberType = typename target::member_type;
+    using LeafParent = typename target::leaf_parent_type;
+    constexpr auto member_props = &detail::member_properties_for<LeafParent, target::leaf_index>;
+    constexpr bool is_bit_field = detail::is_bit_field_member<LeafParent, target::leaf_index>();
+    constexpr auto size = is_bit_field ? detail::layout_for<LeafParent>.members[target::leaf_index].word_size : detail::total_serialized_size<MemberType>();
+    using result_type = result<MemberType>;
+
+    if (!detail::can_access(storage, detail::total_serialized_size<Data>())) {
+        return result_type { error_info { error_kind::storage_exhausted, target::leaf_index, target::offset } };
+    }
+    auto&& source = detail::checked_access(storage, detail::total_serialized_size<Data>());
+    using StorageType = std::remove_reference_t<decltype(source)>;
+
+    std::byte* data;
+    std::array<std::byte, size> buffer;
+    source.seek(target::offset);
+    if constexpr (std::is_base_of_v<memory_storage, StorageType>) {
+        // Check the member in place, but pass over it with the cursor so that views such as
+        // the one of hashing_storage account for the accessed bytes
+        data = source.current;
+        source.current += size;
+    } else {
+        if (!detail::try_read(source, buffer.data(), size)) {
+            return result_type { error_info { error_kind::storage_exhausted, target::leaf_index, target::offset } };
+        }
+        data = buffer.data();
+    }
+    source.seek(-static_cast<std::ptrdiff_t>(target::offset + size));
+
+    error_info error { };
+    if constexpr (is_bit_field) {
+        auto value = detail::decode_bit_field<LeafParent, target::leaf_index, ConstructionPolicy>(data);
+        if (!detail::check_value<member_props>(value, target::offset, target::leaf_index, error)) {
+            return result_type { error };
+        }
+        return result_type { value };
+    } else {
+        if (!detail::check_element<MemberType, member_props, ConstructionPolicy>(data, target::offset, target::leaf_index, error)) {
+            return result_type { error };
+        }
+        memory_storage member_storage { data, data, data + size };
+        return result_type { detail::load_element<MemberType, member_props, memory_storage, detail::prevalidated_policy<ConstructionPolicy>>(member_storage) };
+    }
+}
+
+} // namespace blob
+
+#endif // BLOBIFY_TRY_LOAD_HPP
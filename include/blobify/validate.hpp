@@ -0,0 +1,84 @@
+#ifndef BLOBIFY_VALIDATE_HPP
+#define BLOBIFY_VALIDATE_HPP
+
+#include "memory_storage.hpp"
+#include "result.hpp"
+#include "try_load.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace blob {
+
+/**
+ * Checks count consecutive serialized Data records without decoding them.
+ *
+ * All checks load() would perform (expected_value, validate_enum,
+ * validate_enum_bounds, and the storage size) are applied directly to the
+ * serialized bytes. Members without validation properties are skipped
+ * entirely. Contiguous storages are checked in place; other storages are
+ * read in chunks of multiple records.
+ *
+ * Byte offsets in the reported error are relative to the first record.
+ *
+ * @post On success, advances the input stream by count times the serialized size of Data
+ * @post If a record is invalid, contiguous storages are advanced past the offending record. Other storages may have been advanced further
+ */
+template<typename Data,
+         typename Storage,
+         typename ConstructionPolicy = detail::default_construction_policy>
+result<void> validate_many(Storage&& storage, std::size_t count, tag<ConstructionPolicy> = {}) {
+    static_assert(detail::has_deducible_properties<Data>, "Data properties are not implicitly deducible");
+    static_assert(detail::is_fixed_size<Data>(), "Validation is not supported for variable-length data");
+    constexpr auto size = detail::total_serialized_size<Data>();
+    if (!detail::can_access(storage, size, count)) {
+        return error_info { error_kind::storage_exhausted };
+    }
+    auto&& source = detail::checked_access(storage, size, count);
+    using StorageType = std::remove_reference_t<decltype(source)>;
+
+    error_info error { };
+    if constexpr (std::is_base_of_v<memory_storage, StorageType>) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!detail::check_record<Data, ConstructionPolicy>(source.current + i * size, i * size, error)) {
+                source.current += (i + 1) * size;
+                return error;
+            }
+        }
+        source.current += count * size;
+    } else {
+        // The storage size must be checked even if there is nothing to validate, so all data is read
+        constexpr std::size_t chunk_records = std::max<std::size_t>(4096 / std::max<std::size_t>(size, 1), 1);
+        std::vector<std::byte> buffer(std::min(count, chunk_records) * size);
+        for (std::size_t first = 0; first < count; first += chunk_records) {
+            auto num_records = std::min(count - first, chunk_records);
+            if (!detail::try_read(source, buffer.data(), num_records * size)) {
+                return error_info { error_kind::storage_exhausted, 0, first * size };
+            }
+            for (std::size_t i = 0; i < num_records; ++i) {
+                if (!detail::check_record<Data, ConstructionPolicy>(buffer.data() + i * size, (first + i) * size, error)) {
+                    return error;
+                }
+            }
+        }
+    }
+    return { };
+}
+
+/**
+ * Checks a serialized Data record without decoding it. See validate_many for details.
+ *
+ * @post On success, advances the input stream by the serialized size of Data
+ */
+template<typename Data,
+         typename Storage,
+         typename ConstructionPolicy = detail::default_construction_policy>
+result<void> validate(Storage&& storage, tag<ConstructionPolicy> tag = {}) {
+    return validate_many<Data>(storage, 1, tag);
+}
+
+} // namespace blob
+
+#endif // BLOBIFY_VALIDATE_HPP
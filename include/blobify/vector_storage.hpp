@@ -0,0 +1,165 @@
+#ifndef BLOBIFY_VECTOR_STORAGE_HPP
+#define BLOBIFY_VECTOR_STORAGE_HPP
+
+#include "exceptions.hpp"
+#include "memory_storage.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace blob {
+
+/**
+ * Output storage backend that owns a growable buffer.
+ *
+ * Top-level operations such as store() and store_many() reserve the total
+ * serialized size once up-front, after which the individual member accesses
+ * are plain memory writes without any capacity checks. The buffer grows
+ * geometrically, so repeatedly storing into the same vector_storage only
+ * reallocates a logarithmic number of times.
+ *
+ * The stored data can be handed off without copying using release().
+ * Only stores grow the buffer: Loads and in-place modifications are checked
+ * against the data stored so far, like for checked_memory_storage.
+ */
+class vector_storage {
+public:
+    static constexpr bool growable = true;
+
+    vector_storage() = default;
+
+    /**
+     * Takes ownership of the given buffer and appends to its contents.
+     * The capacity of the buffer is reused, so passing a cleared buffer
+     * avoids any allocation for data that fits its capacity.
+     */
+    explicit vector_storage(std::vector<std::byte> initial_buffer)
+        : buffer(std::move(initial_buffer)) {
+        auto size = buffer.size();
+        buffer.resize(buffer.capacity());
+        reset_pointers(size, size);
+    }
+
+    vector_storage(vector_storage&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    vector_storage& operator=(vector_storage&& other) noexcept {
+        auto position = other.position();
+        auto size = other.size();
+        buffer = std::move(other.buffer);
+        reset_pointers(position, size);
+        other.buffer.clear();
+        other.reset_pointers(0, 0);
+        return *this;
+    }
+
+    // Copies would refer to the buffer of the original object
+    vector_storage(const vector_storage&) = delete;
+    vector_storage& operator=(const vector_storage&) = delete;
+
+    /**
+     * @throws storage_exhausted_exception if fewer than num_bytes bytes have been stored after the cursor
+     */
+    void require(std::size_t num_bytes) const {
+        region.require(num_bytes);
+    }
+
+    /**
+     * Grows the buffer such that num_bytes bytes can be stored starting from the cursor.
+     * Newly added bytes are zero-initialized
+     */
+    void require_store(std::size_t num_bytes) {
+        if (num_bytes > region.remaining()) {
+            grow(position() + num_bytes);
+        }
+    }
+
+    memory_storage& unchecked() {
+        return region.unchecked();
+    }
+
+    /// @throws storage_exhausted_exception if the cursor would leave the stored data
+    void seek(std::ptrdiff_t num_bytes) {
+        region.seek(num_bytes);
+    }
+
+    /// @throws storage_exhausted_exception if fewer than num_bytes bytes have been stored after the cursor
+    void load(std::byte* target, std::size_t num_bytes) {
+        region.load(target, num_bytes);
+    }
+
+    void store(std::byte* source, std::size_t num_bytes) {
+        require_store(num_bytes);
+        region.unchecked().store(source, num_bytes);
+    }
+
+    /// Number of stored bytes after the cursor
+    std::size_t remaining() const {
+        return region.remaining();
+    }
+
+    /// Offset of the cursor from the beginning of the buffer
+    std::size_t position() const {
+        return static_cast<std::size_t>(region.current - region.buffer_begin);
+    }
+
+    /// Number of bytes stored so far
+    std::size_t size() const {
+        return static_cast<std::size_t>(region.buffer_end - region.buffer_begin);
+    }
+
+    const std::byte* data() const {
+        return region.buffer_begin;
+    }
+
+    /// Discards the stored data but keeps the allocated buffer for reuse
+    void clear() {
+        reset_pointers(0, 0);
+    }
+
+    /**
+     * Moves the stored data out of the storage, leaving it empty
+     * @return Buffer holding exactly the stored data
+     */
+    std::vector<std::byte> release() {
+        buffer.resize(size());
+        auto ret = std::move(buffer);
+        buffer.clear();
+        reset_pointers(0, 0);
+        return ret;
+    }
+
+private:
+    void grow(std::size_t new_size) {
+        auto old_size = size();
+        // Spare capacity may still hold data discarded by clear(), whereas resize() zeroes the bytes it adds
+        auto spare_end = std::min(new_size, buffer.size());
+        if (new_size > buffer.size()) {
+            auto position = this->position();
+            buffer.resize(std::max(new_size, 2 * buffer.size()));
+            reset_pointers(position, new_size);
+        } else {
+            region.buffer_end = region.buffer_begin + new_size;
+        }
+        std::fill(buffer.data() + old_size, buffer.data() + spare_end, std::byte { 0 });
+    }
+
+    void reset_pointers(std::size_t position, std::size_t size) {
+        region.buffer_begin = buffer.data();
+        region.current = region.buffer_begin + position;
+        region.buffer_end = region.buffer_begin + size;
+    }
+
+    // Only the first size() bytes hold stored data. The rest is spare capacity
+    std::vector<std::byte> buffer;
+
+    // Stored data and current cursor
+    checked_memory_storage region { { nullptr, nullptr, nullptr } };
+};
+
+} // namespace blob
+
+#endif // BLOBIFY_VECTOR_STORAGE_HPP
@@ -0,0 +1,134 @@
+#include <blobify/blobify.hpp>
+#include <blobify/memory_storage.hpp>
+#include <blobify/stream_storage.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+enum class Mode : std::uint8_t {
+    Off = 0,
+    On = 1,
+    Auto = 3
+};
+
+// 1 + 2 + 5 + 16 + 8 bits packed into a single 32-bit word
+struct Register {
+    bool enable;
+    Mode mode;
+    std::int8_t delta;
+    std::uint16_t value;
+    std::uint8_t reserved;
+};
+
+constexpr auto properties(blob::tag<Register>) {
+    blob::properties_t<Register> props { };
+    props.member<&Register::enable>().bit_width = 1;
+    props.member<&Register::mode>().bit_width = 2;
+    props.member<&Register::mode>().validate_enum = true;
+    props.member<&Register::delta>().bit_width = 5;
+    props.member<&Register::value>().bit_width = 16;
+    props.member<&Register::reserved>().bit_width = 8;
+    props.member<&Register::reserved>().expected_value = std::uint8_t { 0 };
+    return props;
+}
+
+// Big-endian 16-bit word followed by a regular member
+struct Header {
+    std::uint8_t version;
+    std::uint16_t length;
+    std::uint32_t tail;
+};
+
+constexpr auto properties(blob::tag<Header>) {
+    blob::properties_t<Header> props { };
+    props.member<&Header::version>().bit_width = 4;
+    props.member<&Header::version>().endianness = blob::endian::big;
+    props.member<&Header::length>().bit_width = 12;
+    props.member<&Header::length>().endianness = blob::endian::big;
+    return props;
+}
+
+std::uint32_t load_word(const std::vector<std::byte>& buffer) {
+    std::uint32_t word;
+    std::memcpy(&word, buffer.data(), sizeof(word));
+    return word;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Bit-field members share a word") {
+    static_assert(blob::detail::total_serialized_size<Register>() == 4);
+    static_assert(blob::detail::total_serialized_size<Header>() == 6);
+
+    std::vector<std::byte> buffer(16);
+    Register reg { true, Mode::Auto, -3, 0xbeef, 0 };
+    blob::store(blob::memory_storage { buffer.data(), buffer.data(), buffer.data() + buffer.size() }, reg);
+    CHECK(load_word(buffer) == (1u | (3u << 1) | ((static_cast<std::uint32_t>(-3) & 31u) << 3) | (0xbeefu << 8)));
+
+    SECTION("round-trip") {
+        auto loaded = blob::load<Register>(blob::memory_storage { buffer.data(), buffer.data(), buffer.data() + buffer.size() });
+        CHECK(loaded.enable);
+        CHECK(loaded.mode == Mode::Auto);
+        CHECK(loaded.delta == -3); // Sign-extended
+        CHECK(loaded.value == 0xbeef);
+        CHECK(loaded.reserved == 0);
+    }
+
+    SECTION("stream") {
+        std::istringstream stream { std::string { reinterpret_cast<const char*>(buffer.data()), 4 } };
+        auto loaded = blob::load<Register>(blob::istream_storage { { stream } });
+        CHECK(loaded.value == 0xbeef);
+    }
+
+    SECTION("lens") {
+        blob::memory_storage source { buffer.data(), buffer.data(), buffer.data() + buffer.size() };
+        CHECK(blob::lens_load<&Register::delta>(source) == -3);
+        CHECK(blob::lens_load<&Register::value>(source) == 0xbeef);
+        CHECK(source.current == buffer.data());
+    }
+}
+
+TEST_CASE("Bit-field members are validated") {
+    std::vector<std::byte> buffer(16);
+    blob::store(blob::memory_storage { buffer.data(), buffer.data(), buffer.data() + buffer.size() },
+                Register { false, Mode::On, 0, 1, 0 });
+    auto word = load_word(buffer);
+
+    SECTION("invalid enum value") {
+        word = (word & ~(3u << 1)) | (2u << 1);
+        std::memcpy(buffer.data(), &word, sizeof(word));
+        blob::memory_storage source { buffer.data(), buffer.data(), buffer.data() + buffer.size() };
+        CHECK_THROWS_AS(blob::load<Register>(source), blob::invalid_enum_value_exception_for<&Register::mode>);
+    }
+
+    SECTION("unexpected value") {
+        word |= 1u << 30;
+        std::memcpy(buffer.data(), &word, sizeof(word));
+        blob::memory_storage source { buffer.data(), buffer.data(), buffer.data() + buffer.size() };
+        CHECK_THROWS_AS(blob::load<Register>(source), blob::unexpected_value_exception<&Register::reserved>);
+    }
+}
+
+TEST_CASE("Bit-field words honor endianness and truncate on store") {
+    std::vector<std::byte> buffer(16);
+    blob::store(blob::memory_storage { buffer.data(), buffer.data(), buffer.data() + buffer.size() }, Header { 0xa, 0x123, 7 });
+    CHECK(buffer[0] == std::byte { 0x12 });
+    CHECK(buffer[1] == std::byte { 0x3a });
+
+    auto loaded = blob::load<Header>(blob::memory_storage { buffer.data(), buffer.data(), buffer.data() + buffer.size() });
+    CHECK(loaded.version == 0xa);
+    CHECK(loaded.length == 0x123);
+    CHECK(loaded.tail == 7);
+
+    blob::store(blob::memory_storage { buffer.data(), buffer.data(), buffer.data() + buffer.size() }, Header { 0x1f, 0xfff, 0 });
+    loaded = blob::load<Header>(blob::memory_storage { buffer.data(), buffer.data(), buffer.data() + buffer.size() });
+    CHECK(loaded.version == 0xf);
+    CHECK(loaded.length == 0xfff);
+}
@@ -0,0 +1,168 @@
+#include <blobify/blobify.hpp>
+#include <blobify/memory_storage.hpp>
+#include <blobify/stream_storage.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Entry {
+    std::uint32_t id;
+    std::uint16_t a;
+    std::uint16_t b;
+    std::uint64_t value;
+};
+
+constexpr auto properties(blob::tag<Entry>) {
+    blob::properties_t<Entry> props { };
+    props.member<&Entry::b>().endianness = blob::endian::big;
+    return props;
+}
+
+constexpr std::size_t entry_size = 16;
+
+// Smaller than an Entry, and as large as Entry::value
+constexpr std::size_t block_size = 8;
+
+struct Chunk {
+    std::array<std::uint8_t, 20> data;
+};
+
+struct Byte {
+    std::uint8_t value;
+};
+
+struct Word {
+    std::uint16_t value;
+};
+
+std::vector<Entry> make_entries(std::size_t count) {
+    std::vector<Entry> entries;
+    for (std::size_t i = 0; i < count; ++i) {
+        entries.push_back(Entry { static_cast<std::uint32_t>(i), static_cast<std::uint16_t>(i * 2), static_cast<std::uint16_t>(i * 3),
+                                  i * 0x0101010101010101 });
+    }
+    return entries;
+}
+
+std::string serialize(const std::vector<Entry>& entries) {
+    std::string data(entries.size() * entry_size, '\0');
+    auto begin = reinterpret_cast<std::byte*>(data.data());
+    blob::store_many(blob::memory_storage { begin, begin, begin + data.size() }, entries);
+    return data;
+}
+
+bool operator==(const Entry& a, const Entry& b) {
+    return a.id == b.id && a.a == b.a && a.b == b.b && a.value == b.value;
+}
+
+} // anonymous namespace
+
+TEST_CASE("buffered_istream_storage") {
+    auto entries = make_entries(20);
+    std::istringstream stream { serialize(entries) };
+    blob::buffered_istream_storage storage { stream, block_size };
+
+    SECTION("loads records larger than a block") {
+        // Members are loaded from the buffer, except for value which bypasses it
+        CHECK(blob::load_many<std::vector<Entry>>(storage, 20) == entries);
+        CHECK_THROWS_AS(blob::load<Entry>(storage), blob::storage_exhausted_exception);
+    }
+
+    SECTION("lens_load within the buffer") {
+        CHECK(blob::lens_load<&Entry::id>(storage) == 0);
+        // Only the first block has been read
+        CHECK(stream.tellg() == static_cast<std::streamoff>(block_size));
+
+        // Seeks back to the beginning of the blob within the buffer
+        CHECK(blob::lens_load<&Entry::a>(storage) == 0);
+        CHECK(blob::lens_load<&Entry::b>(storage) == 0);
+        CHECK(stream.tellg() == static_cast<std::streamoff>(block_size));
+
+        // Bypasses the buffer, so the stream has to be moved back afterwards
+        storage.seek(entry_size);
+        CHECK(blob::lens_load<&Entry::value>(storage) == 0x0101010101010101);
+        CHECK(blob::lens_load<&Entry::b>(storage) == 3);
+        CHECK(blob::load<Entry>(storage) == entries[1]);
+    }
+
+    SECTION("seeks past the buffered data") {
+        CHECK(blob::lens_load<&Entry::a>(storage) == 0);
+        storage.seek(5 * entry_size);
+        CHECK(blob::load<Entry>(storage) == entries[5]);
+
+        storage.seek(-static_cast<std::ptrdiff_t>(4 * entry_size));
+        CHECK(blob::load<Entry>(storage) == entries[2]);
+        CHECK(blob::load_many<std::vector<Entry>>(storage, 17).back() == entries[19]);
+    }
+
+    SECTION("loads larger than a block") {
+        CHECK(blob::load<Word>(storage).value == 0);
+        // Consumes the rest of the buffered block and reads the remainder directly
+        auto chunk = blob::load<Chunk>(storage);
+        CHECK(std::string(reinterpret_cast<const char*>(chunk.data.data()), chunk.data.size()) == serialize(entries).substr(2, chunk.data.size()));
+
+        storage.seek(-static_cast<std::ptrdiff_t>(2 + chunk.data.size()));
+        CHECK(blob::load<Entry>(storage) == entries[0]);
+    }
+
+    SECTION("partial last block") {
+        // The chunks bypass the buffer, so blocks are read from offset 303 on and the last one holds a single byte
+        auto data = serialize(entries);
+        storage.seek(3);
+        CHECK(blob::load_many<std::vector<Chunk>>(storage, 15).back().data[0] == static_cast<std::uint8_t>(data[3 + 14 * 20]));
+        for (std::size_t offset = 303; offset < data.size(); ++offset) {
+            REQUIRE(blob::load<Byte>(storage).value == static_cast<std::uint8_t>(data[offset]));
+        }
+        CHECK_THROWS_AS(blob::load<Byte>(storage), blob::storage_exhausted_exception);
+
+        // Reaching the end of the stream doesn't prevent seeking back
+        storage.seek(-static_cast<std::ptrdiff_t>(entry_size));
+        CHECK(blob::load<Entry>(storage) == entries[19]);
+    }
+}
+
+TEST_CASE("buffered_ostream_storage") {
+    auto entries = make_entries(20);
+    const auto expected = serialize(entries);
+    std::ostringstream stream;
+
+    SECTION("flushes on destruction") {
+        {
+            blob::buffered_ostream_storage storage { stream, block_size };
+            blob::store_many(storage, entries);
+            blob::store(storage, Word { 0x1234 });
+            CHECK(stream.str() == expected);
+        }
+        CHECK(stream.str().size() == expected.size() + 2);
+        CHECK(stream.str().substr(0, expected.size()) == expected);
+    }
+
+    SECTION("seeks within and past the buffer") {
+        {
+            blob::buffered_ostream_storage storage { stream, block_size };
+            blob::store_many(storage, entries);
+            storage.seek(-static_cast<std::ptrdiff_t>(10 * entry_size));
+
+            // Within the buffer
+            blob::lens_store<&Entry::id>(storage, std::uint32_t { 1234 });
+            blob::lens_store<&Entry::a>(storage, std::uint16_t { 77 });
+
+            // Past the buffer
+            blob::lens_store<&Entry::value>(storage, std::uint64_t { 99 });
+            storage.seek(-static_cast<std::ptrdiff_t>(10 * entry_size));
+            blob::lens_store<&Entry::b>(storage, std::uint16_t { 4321 });
+        }
+        entries[10].id = 1234;
+        entries[10].a = 77;
+        entries[10].value = 99;
+        entries[0].b = 4321;
+        CHECK(stream.str() == serialize(entries));
+    }
+}
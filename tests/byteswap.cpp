@@ -0,0 +1,91 @@
+#include <blobify/detail/byteswap.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+template<typename T>
+T make_value(std::size_t index) {
+    // Distinct bytes within each element, so swapping any two of them is detected
+    std::uint64_t value = 0;
+    for (std::size_t byte = 0; byte < sizeof(T); ++byte) {
+        value |= std::uint64_t { static_cast<std::uint8_t>(index * 16 + byte + 1) } << (8 * byte);
+    }
+    return static_cast<T>(value);
+}
+
+template<typename T>
+T scalar_byteswap(T value) {
+    T result = 0;
+    for (std::size_t byte = 0; byte < sizeof(T); ++byte) {
+        result = static_cast<T>((result << 8) | ((value >> (8 * byte)) & 0xff));
+    }
+    return result;
+}
+
+/**
+ * Element counts around the 16-byte (SSSE3) and 32-byte (AVX2) vector widths,
+ * as well as counts that take both vector loops before the scalar remainder
+ */
+template<typename T>
+std::vector<std::size_t> test_counts() {
+    std::vector<std::size_t> counts { 0, 1 };
+    for (std::size_t width : { 16, 32, 48 }) {
+        counts.push_back(width / sizeof(T) - 1);
+        counts.push_back(width / sizeof(T));
+        counts.push_back(width / sizeof(T) + 1);
+    }
+    return counts;
+}
+
+} // anonymous namespace
+
+TEMPLATE_TEST_CASE("byteswap_n matches a scalar reference", "", std::uint16_t, std::uint32_t, std::uint64_t) {
+    for (auto count : test_counts<TestType>()) {
+        CAPTURE(count);
+
+        // Start one element into a vector-aligned buffer, so the data isn't aligned to the vector width
+        alignas(32) TestType buffer[64 / sizeof(TestType) + 2];
+        TestType* data = buffer + 1;
+        for (std::size_t i = 0; i < count + 1; ++i) {
+            data[i] = make_value<TestType>(i);
+        }
+
+        blob::detail::byteswap_n(data, count);
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(data[i] == scalar_byteswap(make_value<TestType>(i)));
+        }
+        // Elements past the end are left alone
+        CHECK(data[count] == make_value<TestType>(count));
+    }
+}
+
+TEMPLATE_TEST_CASE("byteswap_copy_n matches a scalar reference", "", std::uint16_t, std::uint32_t, std::uint64_t) {
+    for (auto count : test_counts<TestType>()) {
+        CAPTURE(count);
+
+        alignas(32) TestType source_buffer[64 / sizeof(TestType) + 1];
+        const TestType* source = source_buffer + 1;
+        for (std::size_t i = 0; i < count; ++i) {
+            source_buffer[i + 1] = make_value<TestType>(i);
+        }
+
+        // Use a destination that isn't even aligned to the element size
+        alignas(32) std::byte dest_buffer[64 + 2];
+        std::memset(dest_buffer, 0xcc, sizeof(dest_buffer));
+        std::byte* dest = dest_buffer + 1;
+
+        blob::detail::byteswap_copy_n(dest, source, count);
+        for (std::size_t i = 0; i < count; ++i) {
+            TestType value;
+            std::memcpy(&value, dest + i * sizeof(TestType), sizeof(TestType));
+            REQUIRE(value == scalar_byteswap(make_value<TestType>(i)));
+        }
+        CHECK(dest_buffer[0] == std::byte { 0xcc });
+        CHECK(dest[count * sizeof(TestType)] == std::byte { 0xcc });
+    }
+}
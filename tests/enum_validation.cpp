@@ -0,0 +1,121 @@
+#include <blobify/blobify.hpp>
+#include <blobify/memory_storage.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+// Values spanning a range of more than 4096 are looked up using binary search
+enum class Code : std::uint16_t {
+    Continue = 5000,
+    Retry = 5001,
+    Redirect = 7000,
+    Abort = 9100,
+};
+
+template<>
+struct magic_enum::customize::enum_range<Code> {
+    static constexpr int min = 5000;
+    static constexpr int max = 9100;
+};
+
+namespace {
+
+// Values spanning a small range with gaps are looked up in a bitmap
+enum class Flag : std::uint8_t {
+    Ready = 1,
+    Busy = 5,
+    Paused = 64,
+    Failed = 200,
+};
+
+// Values without gaps reduce to a bounds check
+enum class Level : std::int8_t {
+    Lowest = -2,
+    Low = -1,
+    Normal = 0,
+    High = 1,
+    Higher = 2,
+    Highest = 3,
+};
+
+struct Message {
+    Flag flag;
+    Level level;
+    Code code;
+};
+
+constexpr auto properties(blob::tag<Message>) {
+    blob::properties_t<Message> props { };
+    props.member<&Message::flag>().validate_enum = true;
+    props.member<&Message::level>().validate_enum = true;
+    props.member<&Message::code>().validate_enum = true;
+    return props;
+}
+
+template<typename Enum>
+using value_set = blob::detail::enum_value_set<Enum>;
+
+template<typename Enum, typename Underlying>
+constexpr bool contains(Underlying value) {
+    return value_set<Enum>::contains(static_cast<Enum>(value));
+}
+
+static_assert(value_set<Flag>::use_bitmap && !value_set<Flag>::is_contiguous);
+static_assert(value_set<Level>::is_contiguous);
+static_assert(!value_set<Code>::use_bitmap && !value_set<Code>::is_contiguous);
+
+/// Loads a Message with the given raw member values
+Message load_message(std::uint8_t flag, std::int8_t level, std::uint16_t code) {
+    std::byte data[4];
+    std::memcpy(data, &flag, 1);
+    std::memcpy(data + 1, &level, 1);
+    std::memcpy(data + 2, &code, 2);
+    return blob::load<Message>(blob::memory_storage { data, data, data + sizeof(data) });
+}
+
+} // anonymous namespace
+
+TEST_CASE("Enum validation using a bitmap") {
+    for (std::uint8_t value : { 1, 5, 64, 200 }) {
+        CHECK(contains<Flag>(value));
+    }
+    for (std::uint8_t value : { 0, 2, 4, 6, 63, 65, 128, 199, 201, 255 }) {
+        CAPTURE(value);
+        CHECK(!contains<Flag>(value));
+    }
+
+    CHECK(load_message(64, 0, 5000).flag == Flag::Paused);
+    CHECK_THROWS_AS(load_message(63, 0, 5000), blob::invalid_enum_value_exception_for<&Message::flag>);
+    CHECK_THROWS_AS(load_message(201, 0, 5000), blob::invalid_enum_value_exception_for<&Message::flag>);
+}
+
+TEST_CASE("Enum validation of contiguous values") {
+    for (std::int8_t value = -2; value <= 3; ++value) {
+        CHECK(contains<Level>(value));
+    }
+    for (std::int8_t value : { -128, -3, 4, 127 }) {
+        CAPTURE(value);
+        CHECK(!contains<Level>(value));
+    }
+
+    CHECK(load_message(1, -2, 5000).level == Level::Lowest);
+    CHECK(load_message(1, 3, 5000).level == Level::Highest);
+    CHECK_THROWS_AS(load_message(1, -3, 5000), blob::invalid_enum_value_exception_for<&Message::level>);
+    CHECK_THROWS_AS(load_message(1, 4, 5000), blob::invalid_enum_value_exception_for<&Message::level>);
+}
+
+TEST_CASE("Enum validation using binary search") {
+    for (std::uint16_t value : { 5000, 5001, 7000, 9100 }) {
+        CHECK(contains<Code>(value));
+    }
+    for (std::uint16_t value : { 0, 4999, 5002, 6999, 7001, 9099, 9101, 65535 }) {
+        CAPTURE(value);
+        CHECK(!contains<Code>(value));
+    }
+
+    CHECK(load_message(1, 0, 9100).code == Code::Abort);
+    CHECK_THROWS_AS(load_message(1, 0, 4999), blob::invalid_enum_value_exception_for<&Message::code>);
+    CHECK_THROWS_AS(load_message(1, 0, 7001), blob::invalid_enum_value_exception_for<&Message::code>);
+}
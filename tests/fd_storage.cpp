@@ -0,0 +1,175 @@
+#include <blobify/blobify.hpp>
+#include <blobify/fd_storage.hpp>
+#include <blobify/memory_storage.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace {
+
+// The payload is referenced rather than copied by fd_ostream_storage
+struct Record {
+    std::uint32_t id;
+    std::array<std::uint8_t, 300> payload;
+    std::uint16_t checksum;
+};
+
+constexpr std::size_t record_size = 4 + 300 + 2;
+
+struct Small {
+    std::uint32_t id;
+    std::uint16_t value;
+};
+
+constexpr std::size_t small_size = 6;
+
+std::vector<Record> make_records(std::size_t count) {
+    std::vector<Record> records(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        records[i].id = static_cast<std::uint32_t>(i);
+        for (std::size_t j = 0; j < records[i].payload.size(); ++j) {
+            records[i].payload[j] = static_cast<std::uint8_t>(i + j);
+        }
+        records[i].checksum = static_cast<std::uint16_t>(i * 3);
+    }
+    return records;
+}
+
+/// Reference serialization using memory_storage
+std::vector<std::byte> serialize(const Small& header, const std::vector<Record>& records) {
+    std::vector<std::byte> data(small_size + records.size() * record_size);
+    auto storage = blob::memory_storage { data.data(), data.data(), data.data() + data.size() };
+    blob::store(storage, header);
+    blob::store_many(storage, records);
+    return data;
+}
+
+/// Anonymous temporary file
+struct temporary_file {
+    std::FILE* file = std::tmpfile();
+    int fd = ::fileno(file);
+
+    ~temporary_file() {
+        std::fclose(file);
+    }
+
+    std::size_t size() const {
+        struct stat info { };
+        ::fstat(fd, &info);
+        return static_cast<std::size_t>(info.st_size);
+    }
+
+    std::vector<std::byte> contents() const {
+        std::vector<std::byte> data(size());
+        std::size_t num_read = 0;
+        while (num_read < data.size()) {
+            auto result = ::pread(fd, data.data() + num_read, data.size() - num_read, static_cast<off_t>(num_read));
+            REQUIRE(result > 0);
+            num_read += static_cast<std::size_t>(result);
+        }
+        return data;
+    }
+};
+
+} // anonymous namespace
+
+TEST_CASE("fd_ostream_storage writes the same data as memory_storage") {
+    temporary_file file;
+    REQUIRE(file.file);
+
+    // Each record adds one range for the buffered members and one for the payload.
+    // With a large flush threshold, the pending ranges exceed the writev limit
+    const Small header { 0x424c4f42, 1 };
+    auto records = make_records(2000);
+    {
+        blob::fd_ostream_storage storage { file.fd, 4 * 1024 * 1024 };
+        blob::store(storage, header);
+        blob::store_many(storage, records);
+        storage.flush();
+    }
+    CHECK(file.contents() == serialize(header, records));
+}
+
+TEST_CASE("fd_ostream_storage writes borrowed data at the end of each operation") {
+    temporary_file file;
+    REQUIRE(file.file);
+
+    const Small header { 1, 2 };
+    auto records = make_records(1);
+    blob::fd_ostream_storage storage { file.fd };
+
+    // Small members are buffered
+    blob::store(storage, header);
+    CHECK(file.size() == 0);
+
+    // Written before store() returns, since the source data may be modified afterwards
+    blob::store(storage, records[0]);
+    CHECK(file.size() == small_size + record_size);
+    CHECK(file.contents() == serialize(header, records));
+
+    blob::store(storage, header);
+    CHECK(file.size() == small_size + record_size);
+    storage.flush();
+    CHECK(file.size() == 2 * small_size + record_size);
+}
+
+TEST_CASE("fd_ostream_storage resumes partial writes") {
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+
+    // Signals interrupting a blocked writev make it return the number of bytes written so far
+    struct sigaction action { };
+    action.sa_handler = [](int) { };
+    struct sigaction previous_action { };
+    REQUIRE(::sigaction(SIGALRM, &action, &previous_action) == 0);
+
+    // The reader thread inherits the blocked signal mask, so the signals are delivered to the writer
+    sigset_t alarm_set;
+    sigemptyset(&alarm_set);
+    sigaddset(&alarm_set, SIGALRM);
+    ::pthread_sigmask(SIG_BLOCK, &alarm_set, nullptr);
+    std::vector<std::byte> received;
+    std::thread reader { [&] {
+        std::byte chunk[4096];
+        ssize_t num_read;
+        while ((num_read = ::read(fds[0], chunk, sizeof(chunk))) > 0) {
+            received.insert(received.end(), chunk, chunk + num_read);
+            std::this_thread::sleep_for(std::chrono::microseconds { 20 });
+        }
+    } };
+    ::pthread_sigmask(SIG_UNBLOCK, &alarm_set, nullptr);
+
+    itimerval timer { { 0, 100 }, { 0, 100 } };
+    ::setitimer(ITIMER_REAL, &timer, nullptr);
+
+    const Small header { 3, 4 };
+    auto records = make_records(2000);
+    {
+        // Each flush writes more data than fits into the pipe
+        blob::fd_ostream_storage storage { fds[1], 256 * 1024 };
+        blob::store(storage, header);
+        blob::store_many(storage, records);
+        storage.flush();
+    }
+
+    timer = { };
+    ::setitimer(ITIMER_REAL, &timer, nullptr);
+    ::sigaction(SIGALRM, &previous_action, nullptr);
+    ::close(fds[1]);
+    reader.join();
+    ::close(fds[0]);
+
+    CHECK(received == serialize(header, records));
+}
@@ -0,0 +1,115 @@
+#include <blobify/blobify.hpp>
+#include <blobify/memory_storage.hpp>
+#include <blobify/stream_storage.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Sample {
+    float x;
+    double y;
+    std::array<float, 4> values;
+    std::uint8_t tag;
+};
+
+constexpr auto properties(blob::tag<Sample>) {
+    blob::properties_t<Sample> props { };
+    props.member<&Sample::y>().endianness = blob::endian::big;
+    props.member<&Sample::values>().endianness = blob::endian::big;
+    return props;
+}
+
+struct Unit {
+    float one;
+};
+
+constexpr auto properties(blob::tag<Unit>) {
+    blob::properties_t<Unit> props { };
+    props.member<&Unit::one>().expected_value = 1.0f;
+    return props;
+}
+
+template<typename T, typename Bits>
+T from_big_endian(const std::byte* data) {
+    static_assert(sizeof(T) == sizeof(Bits));
+    Bits bits = 0;
+    for (std::size_t i = 0; i < sizeof(Bits); ++i) {
+        bits = static_cast<Bits>((bits << 8) | static_cast<Bits>(data[i]));
+    }
+    T value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+constexpr auto big_endian_float = [] {
+    blob::element_properties_t<float, void> props { };
+    props.endianness = blob::endian::big;
+    return props;
+}();
+
+const Sample sample { 1.5f, -2.25, { 0.f, -0.f, std::numeric_limits<float>::infinity(), 1e-30f }, 9 };
+constexpr std::size_t sample_size = 4 + 8 + 16 + 1;
+
+} // anonymous namespace
+
+TEST_CASE("Floating-point members are byte-swapped") {
+    static_assert(blob::detail::total_serialized_size<Sample>() == sample_size);
+
+    std::vector<std::byte> buffer(64);
+    blob::store(blob::memory_storage { buffer.data(), buffer.data(), buffer.data() + buffer.size() }, sample);
+
+    float x;
+    std::memcpy(&x, buffer.data(), sizeof(x));
+    CHECK(x == 1.5f);
+    CHECK(from_big_endian<double, std::uint64_t>(buffer.data() + 4) == -2.25);
+    CHECK(std::isinf(from_big_endian<float, std::uint32_t>(buffer.data() + 12 + 8)));
+
+    SECTION("memory") {
+        auto loaded = blob::load<Sample>(blob::memory_storage { buffer.data(), buffer.data(), buffer.data() + buffer.size() });
+        CHECK(loaded.x == 1.5f);
+        CHECK(loaded.y == -2.25);
+        CHECK(std::signbit(loaded.values[1]));
+        CHECK(loaded.values[3] == 1e-30f);
+        CHECK(loaded.tag == 9);
+    }
+
+    SECTION("stream") {
+        std::istringstream stream { std::string { reinterpret_cast<const char*>(buffer.data()), sample_size } };
+        auto loaded = blob::load<Sample>(blob::istream_storage { { stream } });
+        CHECK(loaded.y == -2.25);
+        CHECK(std::isinf(loaded.values[2]));
+    }
+}
+
+TEST_CASE("Floating-point arrays are converted in bulk") {
+    std::vector<float> values(100);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<float>(i) * 0.5f - 7.f;
+    }
+
+    std::vector<std::byte> buffer(values.size() * sizeof(float));
+    blob::store_many_explicit<&big_endian_float>(blob::memory_storage { buffer.data(), buffer.data(), buffer.data() + buffer.size() }, values);
+    CHECK(from_big_endian<float, std::uint32_t>(buffer.data() + 4) == -6.5f);
+
+    auto loaded = blob::load_many_explicit<std::vector<float>, &big_endian_float>(
+            blob::memory_storage { buffer.data(), buffer.data(), buffer.data() + buffer.size() }, values.size());
+    CHECK(loaded == values);
+}
+
+TEST_CASE("Floating-point members are validated") {
+    std::vector<std::byte> buffer(4);
+    blob::store(blob::memory_storage { buffer.data(), buffer.data(), buffer.data() + buffer.size() }, Unit { 2.0f });
+
+    blob::memory_storage source { buffer.data(), buffer.data(), buffer.data() + buffer.size() };
+    CHECK_THROWS_AS(blob::load<Unit>(source), blob::unexpected_value_exception<&Unit::one>);
+}
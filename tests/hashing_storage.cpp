@@ -0,0 +1,254 @@
+#include <blobify/blobify.hpp>
+#include <blobify/hashing_storage.hpp>
+#include <blobify/memory_storage.hpp>
+#include <blobify/stream_storage.hpp>
+#include <blobify/try_load.hpp>
+#include <blobify/validate.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Header {
+    std::uint32_t magic;
+    std::uint32_t size;
+    std::uint32_t flags;
+};
+
+constexpr std::size_t header_size = 12;
+
+// Byte-swapped arrays are converted directly into contiguous storages
+struct Samples {
+    std::array<std::uint16_t, 4> values;
+    std::uint8_t scale;
+};
+
+constexpr auto properties(blob::tag<Samples>) {
+    blob::properties_t<Samples> props { };
+    props.member<&Samples::values>().endianness = blob::endian::big;
+    props.member<&Samples::scale>().expected_value = std::uint8_t { 2 };
+    return props;
+}
+
+constexpr std::size_t samples_size = 9;
+
+// Both arrays are larger than the interval in which contiguous storages hash the accessed data
+struct Waveform {
+    std::uint16_t channel;
+    std::array<std::uint32_t, 5000> big_endian;
+    std::array<std::uint32_t, 5000> native;
+};
+
+constexpr auto properties(blob::tag<Waveform>) {
+    blob::properties_t<Waveform> props { };
+    props.member<&Waveform::big_endian>().endianness = blob::endian::big;
+    return props;
+}
+
+constexpr std::size_t waveform_size = 2 + 2 * 5000 * 4;
+
+std::uint32_t crc32c_of(const std::byte* data, std::size_t num_bytes) {
+    blob::crc32c hasher;
+    hasher.update(data, num_bytes);
+    return hasher.digest();
+}
+
+} // anonymous namespace
+
+TEST_CASE("Checksums don't depend on the underlying storage") {
+    const Header header { 0x424c4f42, 12, 3 };
+    std::byte buffer[header_size] { };
+    auto memory_target = blob::checked_memory_storage::OnArray(buffer);
+    blob::store(memory_target, header);
+    std::string serialized(reinterpret_cast<const char*>(buffer), header_size);
+
+    auto memory_digest = [&](auto&& operation) {
+        auto memory = blob::checked_memory_storage::OnArray(buffer);
+        blob::hashing_storage hashed { memory };
+        operation(hashed);
+        return hashed.digest();
+    };
+    auto stream_digest = [&](auto&& operation) {
+        std::istringstream stream { serialized };
+        blob::istream_storage source { { stream } };
+        blob::hashing_storage hashed { source };
+        operation(hashed);
+        return hashed.digest();
+    };
+
+    SECTION("load") {
+        auto load = [](auto& storage) { CHECK(blob::load<Header>(storage).flags == 3); };
+        CHECK(memory_digest(load) == crc32c_of(buffer, header_size));
+        CHECK(stream_digest(load) == crc32c_of(buffer, header_size));
+    }
+
+    SECTION("lens_load") {
+        // Only the bytes of the loaded member are hashed
+        auto lens_load = [](auto& storage) { CHECK(blob::lens_load<&Header::size>(storage) == 12); };
+        CHECK(memory_digest(lens_load) == crc32c_of(buffer + 4, 4));
+        CHECK(stream_digest(lens_load) == crc32c_of(buffer + 4, 4));
+    }
+
+    SECTION("try_lens_load") {
+        auto try_lens_load = [](auto& storage) {
+            auto size = blob::try_lens_load<&Header::size>(storage);
+            REQUIRE(size);
+            CHECK(*size == 12);
+        };
+        CHECK(memory_digest(try_lens_load) == crc32c_of(buffer + 4, 4));
+        CHECK(stream_digest(try_lens_load) == crc32c_of(buffer + 4, 4));
+    }
+
+    SECTION("store") {
+        std::byte target_buffer[header_size] { };
+        auto memory = blob::checked_memory_storage::OnArray(target_buffer);
+        blob::hashing_storage hashed_memory { memory };
+        blob::store(hashed_memory, header);
+
+        std::ostringstream stream;
+        blob::ostream_storage target { { stream } };
+        blob::hashing_storage hashed_stream { target };
+        blob::store(hashed_stream, header);
+
+        CHECK(hashed_memory.digest() == crc32c_of(buffer, header_size));
+        CHECK(hashed_stream.digest() == hashed_memory.digest());
+    }
+}
+
+TEST_CASE("Checksums over many records on contiguous storages") {
+    std::vector<Header> headers;
+    for (std::uint32_t i = 0; i < 100; ++i) {
+        headers.push_back(Header { i, 2 * i, 3 * i });
+    }
+    std::vector<std::byte> buffer(headers.size() * header_size);
+    auto reference = blob::memory_storage { buffer.data(), buffer.data(), buffer.data() + buffer.size() };
+    blob::store_many(reference, headers);
+
+    SECTION("load_many") {
+        auto memory = blob::checked_memory_storage { { buffer.data(), buffer.data(), buffer.data() + buffer.size() } };
+        blob::hashing_storage hashed { memory };
+        CHECK(blob::load_many<std::vector<Header>>(hashed, 100)[99].flags == 297);
+        CHECK(hashed.digest() == crc32c_of(buffer.data(), buffer.size()));
+
+        // The cursor of the underlying storage is advanced
+        CHECK(memory.current == buffer.data() + buffer.size());
+        CHECK_THROWS_AS(blob::load<Header>(hashed), blob::storage_exhausted_exception);
+        CHECK(hashed.digest() == crc32c_of(buffer.data(), buffer.size()));
+    }
+
+    SECTION("lens_load on unchecked storage") {
+        auto memory = blob::memory_storage { buffer.data(), buffer.data(), buffer.data() + buffer.size() };
+        blob::hashing_storage hashed { memory };
+        blob::crc32c expected;
+        for (std::uint32_t i = 0; i < 100; ++i) {
+            CHECK(blob::lens_load<&Header::size>(hashed) == 2 * i);
+            expected.update(buffer.data() + i * header_size + 4, 4);
+            memory.seek(header_size);
+        }
+        CHECK(memory.current == buffer.data() + buffer.size());
+        CHECK(hashed.digest() == expected.digest());
+    }
+
+    SECTION("store_many") {
+        std::vector<std::byte> target_buffer(buffer.size());
+        auto memory = blob::checked_memory_storage { { target_buffer.data(), target_buffer.data(), target_buffer.data() + target_buffer.size() } };
+        blob::hashing_storage hashed { memory };
+        blob::store_many(hashed, headers);
+        CHECK(target_buffer == buffer);
+        CHECK(memory.current == target_buffer.data() + target_buffer.size());
+        CHECK(hashed.digest() == crc32c_of(buffer.data(), buffer.size()));
+    }
+}
+
+TEST_CASE("Data accessed in place is hashed") {
+    std::vector<Samples> samples(10, Samples { { 1, 2, 3, 4 }, 2 });
+    std::vector<std::byte> buffer(samples.size() * samples_size);
+    auto reference = blob::memory_storage { buffer.data(), buffer.data(), buffer.data() + buffer.size() };
+    blob::store_many(reference, samples);
+    const auto expected = crc32c_of(buffer.data(), buffer.size());
+
+    std::vector<std::byte> target_buffer(buffer.size());
+    auto target = blob::checked_memory_storage { { target_buffer.data(), target_buffer.data(), target_buffer.data() + target_buffer.size() } };
+    blob::hashing_storage hashed_target { target };
+
+    SECTION("store") {
+        for (auto& sample : samples) {
+            blob::store(hashed_target, sample);
+        }
+        CHECK(target_buffer == buffer);
+        CHECK(hashed_target.digest() == expected);
+    }
+
+    SECTION("store_many") {
+        blob::store_many(hashed_target, samples);
+        CHECK(target_buffer == buffer);
+        CHECK(hashed_target.digest() == expected);
+    }
+
+    auto source = blob::checked_memory_storage { { buffer.data(), buffer.data(), buffer.data() + buffer.size() } };
+    blob::hashing_storage hashed_source { source };
+
+    SECTION("try_load_many") {
+        REQUIRE(blob::try_load_many<std::vector<Samples>>(hashed_source, samples.size()));
+        CHECK(hashed_source.digest() == expected);
+    }
+
+    SECTION("validate_many") {
+        CHECK(blob::validate_many<Samples>(hashed_source, samples.size()));
+        CHECK(source.current == buffer.data() + buffer.size());
+        CHECK(hashed_source.digest() == expected);
+    }
+}
+
+TEST_CASE("Checksums over data larger than the checkpoint interval") {
+    std::vector<Waveform> waveforms(3);
+    for (std::uint16_t i = 0; i < waveforms.size(); ++i) {
+        waveforms[i].channel = i;
+        for (std::uint32_t j = 0; j < 5000; ++j) {
+            waveforms[i].big_endian[j] = i * 5000 + j;
+            waveforms[i].native[j] = ~(i * 5000 + j);
+        }
+    }
+    std::vector<std::byte> buffer(waveforms.size() * waveform_size);
+    blob::store_many(blob::memory_storage { buffer.data(), buffer.data(), buffer.data() + buffer.size() }, waveforms);
+    const auto expected = crc32c_of(buffer.data(), buffer.size());
+
+    SECTION("load_many") {
+        auto memory = blob::checked_memory_storage { { buffer.data(), buffer.data(), buffer.data() + buffer.size() } };
+        blob::hashing_storage hashed { memory };
+        auto loaded = blob::load_many<std::vector<Waveform>>(hashed, waveforms.size());
+        CHECK(loaded[2].big_endian[4999] == 14999);
+        CHECK(loaded[2].native[4999] == ~std::uint32_t { 14999 });
+        CHECK(memory.current == buffer.data() + buffer.size());
+        CHECK(hashed.digest() == expected);
+    }
+
+    SECTION("store_many") {
+        std::vector<std::byte> target_buffer(buffer.size());
+        auto memory = blob::checked_memory_storage { { target_buffer.data(), target_buffer.data(), target_buffer.data() + target_buffer.size() } };
+        blob::hashing_storage hashed { memory };
+        blob::store_many(hashed, waveforms);
+        CHECK(target_buffer == buffer);
+        CHECK(hashed.digest() == expected);
+    }
+
+    SECTION("many small records") {
+        std::vector<Header> headers(2000, Header { 1, 2, 3 });
+        std::vector<std::byte> headers_buffer(headers.size() * header_size);
+        auto memory = blob::checked_memory_storage { { headers_buffer.data(), headers_buffer.data(), headers_buffer.data() + headers_buffer.size() } };
+        blob::hashing_storage hashed { memory };
+        blob::store_many(hashed, headers);
+        CHECK(hashed.digest() == crc32c_of(headers_buffer.data(), headers_buffer.size()));
+
+        memory.current = headers_buffer.data();
+        hashed.reset();
+        CHECK(blob::load_many<std::vector<Header>>(hashed, headers.size()).back().flags == 3);
+        CHECK(hashed.digest() == crc32c_of(headers_buffer.data(), headers_buffer.size()));
+    }
+}
@@ -0,0 +1,122 @@
+#include <blobify/blobify.hpp>
+#include <blobify/incremental_decoder.hpp>
+#include <blobify/memory_storage.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace {
+
+struct Packet {
+    std::uint16_t magic;
+    std::uint32_t sequence;
+    std::uint8_t flags;
+};
+
+constexpr auto properties(blob::tag<Packet>) {
+    blob::properties_t<Packet> props { };
+    props.member<&Packet::magic>().expected_value = std::uint16_t { 0x5041 };
+    props.member<&Packet::sequence>().endianness = blob::endian::big;
+    return props;
+}
+
+constexpr std::size_t packet_size = 7;
+
+std::vector<std::byte> serialize(std::uint32_t count) {
+    std::vector<Packet> packets;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        packets.push_back(Packet { 0x5041, i, static_cast<std::uint8_t>(i * 3) });
+    }
+    std::vector<std::byte> data(count * packet_size);
+    blob::store_many(blob::memory_storage { data.data(), data.data(), data.data() + data.size() }, packets);
+    return data;
+}
+
+} // anonymous namespace
+
+TEST_CASE("incremental_decoder assembles records from single bytes") {
+    auto data = serialize(2);
+    blob::incremental_decoder<Packet> decoder;
+    static_assert(decltype(decoder)::record_size == packet_size);
+
+    for (std::size_t i = 0; i < packet_size; ++i) {
+        CHECK(decoder.bytes_needed() == packet_size - i);
+        CHECK(!decoder.ready());
+        CHECK(decoder.feed(&data[i], 1) == 1);
+    }
+    CHECK(decoder.ready());
+    CHECK(decoder.bytes_needed() == 0);
+
+    // No bytes are consumed until the decoded record is taken
+    CHECK(decoder.feed(&data[packet_size], 1) == 0);
+    auto packet = decoder.take();
+    CHECK(packet.sequence == 0);
+    CHECK(packet.flags == 0);
+
+    CHECK(decoder.bytes_needed() == packet_size);
+    CHECK(decoder.feed(&data[packet_size], 3) == 3);
+    CHECK(decoder.bytes_needed() == packet_size - 3);
+    CHECK(decoder.feed(&data[packet_size + 3], packet_size - 3) == packet_size - 3);
+    REQUIRE(decoder.ready());
+    packet = decoder.take();
+    CHECK(packet.sequence == 1);
+    CHECK(packet.flags == 3);
+}
+
+TEST_CASE("incremental_decoder::feed_all retains partial records across calls") {
+    auto data = serialize(20);
+    blob::incremental_decoder<Packet> decoder;
+    std::vector<Packet> packets;
+
+    // Chunk sizes chosen so that records are split at varying offsets, including chunks within a single record
+    std::size_t offset = 0;
+    for (std::size_t chunk_size : { 10, 2, 1, 30, 4, 50, 7, 36 }) {
+        decoder.feed_all(&data[offset], chunk_size, std::back_inserter(packets));
+        offset += chunk_size;
+        CHECK(packets.size() == offset / packet_size);
+        CHECK(decoder.bytes_needed() == packet_size - offset % packet_size);
+    }
+    REQUIRE(offset == data.size());
+    REQUIRE(packets.size() == 20);
+    for (std::uint32_t i = 0; i < 20; ++i) {
+        CHECK(packets[i].sequence == i);
+        CHECK(packets[i].flags == static_cast<std::uint8_t>(i * 3));
+    }
+
+    // Partial records are dropped by reset()
+    decoder.feed_all(data.data(), 3, std::back_inserter(packets));
+    decoder.reset();
+    CHECK(decoder.bytes_needed() == packet_size);
+}
+
+TEST_CASE("incremental_decoder continues after invalid records") {
+    auto data = serialize(4);
+    data[packet_size] = std::byte { 0 };
+    data[2 * packet_size] = std::byte { 0 };
+    blob::incremental_decoder<Packet> decoder;
+
+    CHECK(decoder.feed(data.data(), data.size()) == packet_size);
+    CHECK(decoder.take().sequence == 0);
+
+    SECTION("decoded in place") {
+        CHECK_THROWS_AS(decoder.feed(&data[packet_size], data.size() - packet_size), blob::unexpected_value_exception<&Packet::magic>);
+        CHECK(decoder.bytes_needed() == packet_size);
+        CHECK_THROWS_AS(decoder.feed(&data[2 * packet_size], data.size() - 2 * packet_size), blob::unexpected_value_exception<&Packet::magic>);
+    }
+
+    SECTION("assembled from fragments") {
+        CHECK(decoder.feed(&data[packet_size], 4) == 4);
+        CHECK_THROWS_AS(decoder.feed(&data[packet_size + 4], 5), blob::unexpected_value_exception<&Packet::magic>);
+        CHECK(decoder.bytes_needed() == packet_size);
+        CHECK(decoder.feed(&data[2 * packet_size], 2) == 2);
+        CHECK_THROWS_AS(decoder.feed(&data[2 * packet_size + 2], 5), blob::unexpected_value_exception<&Packet::magic>);
+    }
+
+    CHECK(decoder.bytes_needed() == packet_size);
+    CHECK(decoder.feed(&data[3 * packet_size], packet_size) == packet_size);
+    REQUIRE(decoder.ready());
+    CHECK(decoder.take().sequence == 3);
+}
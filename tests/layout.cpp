@@ -0,0 +1,126 @@
+#include <blobify/blobify.hpp>
+#include <blobify/memory_storage.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <utility>
+
+namespace {
+
+enum class Mode : std::uint16_t {
+    Off = 0,
+    On = 1,
+};
+
+struct Point {
+    float x;
+    float y;
+    std::uint8_t weight;
+};
+
+struct Segment {
+    Point from;
+    Point to;
+    bool closed;
+};
+
+struct Shape {
+    std::uint8_t kind;
+    Segment first;
+    Segment second;
+    Mode mode;
+    std::array<std::uint16_t, 5> indices;
+    Point center;
+    std::uint64_t id;
+};
+
+constexpr auto properties(blob::tag<Shape>) {
+    blob::properties_t<Shape> props { };
+    props.member<&Shape::mode>().endianness = blob::endian::big;
+    props.member<&Shape::indices>().endianness = blob::endian::big;
+    return props;
+}
+
+/**
+ * Reference implementation of member offsets and sizes, which builds up the
+ * offset of each member by recursing over the members preceding it
+ */
+template<typename Data>
+constexpr std::size_t reference_size();
+
+template<typename Data, std::size_t Idx>
+constexpr std::size_t reference_member_size() {
+    constexpr auto props = blob::detail::member_properties_for<Data, Idx>;
+    using member_type = boost::pfr::tuple_element_t<Idx, Data>;
+    if constexpr (props.has_representative_type) {
+        constexpr auto representative_size = sizeof(typename decltype(props)::representative_type);
+        if constexpr (blob::detail::is_std_array_v<member_type>) {
+            return representative_size * std::tuple_size_v<member_type>;
+        } else {
+            return representative_size;
+        }
+    } else {
+        return reference_size<member_type>();
+    }
+}
+
+template<typename Data, std::size_t Idx>
+constexpr std::size_t reference_member_offset() {
+    if constexpr (Idx == 0) {
+        return 0;
+    } else {
+        return reference_member_size<Data, Idx - 1>() + reference_member_offset<Data, Idx - 1>();
+    }
+}
+
+template<typename Data>
+constexpr std::size_t reference_size() {
+    if constexpr (blob::detail::is_std_array_v<Data>) {
+        return std::tuple_size_v<Data> * reference_size<typename Data::value_type>();
+    } else if constexpr (std::is_class_v<Data>) {
+        return reference_member_offset<Data, boost::pfr::tuple_size_v<Data>>();
+    } else {
+        return sizeof(blob::detail::select_representative<Data>());
+    }
+}
+
+template<typename Data, std::size_t... Idxs>
+constexpr bool matches_reference(std::index_sequence<Idxs...>) {
+    constexpr auto& layout = blob::detail::layout_for<Data>;
+    return layout.size == reference_size<Data>() &&
+           ((layout.members[Idxs].offset == reference_member_offset<Data, Idxs>() &&
+             layout.members[Idxs].size == reference_member_size<Data, Idxs>()) && ...);
+}
+
+template<typename Data>
+constexpr bool matches_reference() {
+    return matches_reference<Data>(std::make_index_sequence<boost::pfr::tuple_size_v<Data>> { });
+}
+
+} // anonymous namespace
+
+static_assert(matches_reference<Point>());
+static_assert(matches_reference<Segment>());
+static_assert(matches_reference<Shape>());
+
+static_assert(blob::detail::layout_for<Shape>.members[3].offset == 1 + 2 * (2 * 9 + 1));
+static_assert(blob::detail::total_serialized_size<Shape>() == 1 + 2 * 19 + 2 + 10 + 9 + 8);
+
+TEST_CASE("Lenses use the offsets of the layout table") {
+    Shape shape { };
+    shape.second.to.weight = 7;
+    shape.indices[4] = 0x1234;
+    shape.id = 42;
+
+    std::byte buffer[blob::detail::total_serialized_size<Shape>()];
+    auto storage = blob::memory_storage { buffer, buffer, buffer + sizeof(buffer) };
+    blob::store(storage, shape);
+    storage.seek(-static_cast<std::ptrdiff_t>(sizeof(buffer)));
+
+    CHECK(blob::lens_load<&Shape::second, &Segment::to, &Point::weight>(storage) == 7);
+    CHECK(blob::lens_load<&Shape::indices>(storage)[4] == 0x1234);
+    CHECK(blob::lens_load<&Shape::center, &Point::weight>(storage) == 0);
+    CHECK(blob::lens_load<&Shape::id>(storage) == 42);
+}
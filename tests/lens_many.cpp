@@ -0,0 +1,143 @@
+#include <blobify/blobify.hpp>
+#include <blobify/memory_storage.hpp>
+#include <blobify/stream_storage.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+struct Header {
+    std::uint32_t a;
+    std::uint8_t b;
+    std::uint16_t c;
+    std::uint8_t d;
+};
+
+constexpr auto properties(blob::tag<Header>) {
+    blob::properties_t<Header> props { };
+    props.member<&Header::c>().endianness = blob::endian::big;
+    return props;
+}
+
+constexpr std::size_t header_size = 8;
+
+const Header header { 0x01020304, 5, 0x0607, 8 };
+
+std::vector<std::byte> serialize(const Header& value) {
+    std::vector<std::byte> data(header_size);
+    blob::store(blob::memory_storage { data.data(), data.data(), data.data() + data.size() }, value);
+    return data;
+}
+
+/// Forwards to an istream_storage and records all seeks
+struct recording_storage {
+    blob::istream_storage& storage;
+    std::vector<std::ptrdiff_t> seeks;
+
+    void seek(std::ptrdiff_t num_bytes) {
+        seeks.push_back(num_bytes);
+        storage.seek(num_bytes);
+    }
+
+    void load(std::byte* target, std::size_t num_bytes) {
+        storage.load(target, num_bytes);
+    }
+};
+
+/// Stores the complement of each value
+struct inverting_policy : blob::detail::default_construction_policy {
+    template<typename T, typename Representative, blob::endian SourceEndianness>
+    static T decode(Representative source) {
+        return default_construction_policy::decode<T, Representative, SourceEndianness>(static_cast<Representative>(~source));
+    }
+
+    template<typename Representative, typename T, blob::endian TargetEndianness>
+    static Representative encode(const T& value) {
+        return static_cast<Representative>(~default_construction_policy::encode<Representative, T, TargetEndianness>(value));
+    }
+};
+
+} // anonymous namespace
+
+TEST_CASE("lens_load_many") {
+    auto data = serialize(header);
+
+    SECTION("returns members in the given order") {
+        auto storage = blob::memory_storage { data.data(), data.data(), data.data() + data.size() };
+        auto [d, a, c] = blob::lens_load_many<&Header::d, &Header::a, &Header::c>(storage);
+        CHECK(d == 8);
+        CHECK(a == 0x01020304);
+        CHECK(c == 0x0607);
+        CHECK(storage.current == data.data());
+
+        CHECK(blob::lens_load_many<&Header::b>(storage) == std::tuple { std::uint8_t { 5 } });
+        CHECK(storage.current == data.data());
+    }
+
+    SECTION("reads the members in a single forward pass") {
+        std::istringstream stream { std::string(reinterpret_cast<const char*>(data.data()), data.size()) };
+        blob::istream_storage source { { stream } };
+        recording_storage storage { source, { } };
+        auto [c, a] = blob::lens_load_many<&Header::c, &Header::a>(storage);
+        CHECK(c == 0x0607);
+        CHECK(a == 0x01020304);
+
+        // Skips b, then seeks back to the beginning of the blob
+        CHECK(storage.seeks == std::vector<std::ptrdiff_t> { 1, -7 });
+    }
+
+    SECTION("with construction policy") {
+        for (auto& byte : data) {
+            byte = ~byte;
+        }
+        auto storage = blob::memory_storage { data.data(), data.data(), data.data() + data.size() };
+        auto [c, b] = blob::lens_load_many<&Header::c, &Header::b>(storage, blob::tag<inverting_policy> { });
+        CHECK(c == 0x0607);
+        CHECK(b == 5);
+    }
+
+    SECTION("bounds checking") {
+        auto storage = blob::checked_memory_storage { { data.data(), data.data(), data.data() + data.size() - 1 } };
+        CHECK_THROWS_AS((blob::lens_load_many<&Header::a, &Header::b>(storage)), blob::storage_exhausted_exception);
+        CHECK(storage.current == data.data());
+    }
+}
+
+TEST_CASE("lens_store_many") {
+    auto data = serialize(header);
+
+    SECTION("stores members in the given order") {
+        auto storage = blob::memory_storage { data.data(), data.data(), data.data() + data.size() };
+        blob::lens_store_many<&Header::c, &Header::a>(storage, std::uint16_t { 0x1112 }, std::uint32_t { 0x13141516 });
+        CHECK(storage.current == data.data());
+        CHECK(data == serialize(Header { 0x13141516, 5, 0x1112, 8 }));
+    }
+
+    SECTION("through ostream_storage") {
+        std::ostringstream stream { std::string(reinterpret_cast<const char*>(data.data()), data.size()) };
+        blob::ostream_storage storage { { stream } };
+        blob::lens_store_many<&Header::d, &Header::b>(storage, std::uint8_t { 0x21 }, std::uint8_t { 0x22 });
+        CHECK(stream.tellp() == 0);
+
+        auto expected = serialize(Header { 0x01020304, 0x22, 0x0607, 0x21 });
+        CHECK(stream.str() == std::string(reinterpret_cast<const char*>(expected.data()), expected.size()));
+    }
+
+    SECTION("with construction policy") {
+        auto storage = blob::memory_storage { data.data(), data.data(), data.data() + data.size() };
+        blob::lens_store_many<&Header::d, &Header::c>(storage, std::uint8_t { 0x31 }, std::uint16_t { 0x3233 }, blob::tag<inverting_policy> { });
+        CHECK(storage.current == data.data());
+
+        auto [c, d] = blob::lens_load_many<&Header::c, &Header::d>(storage, blob::tag<inverting_policy> { });
+        CHECK(c == 0x3233);
+        CHECK(d == 0x31);
+        CHECK(blob::lens_load<&Header::a>(storage) == 0x01020304);
+        CHECK(data[7] == ~std::byte { 0x31 });
+    }
+}
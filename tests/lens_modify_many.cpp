@@ -0,0 +1,140 @@
+#include <blobify/blobify.hpp>
+#include <blobify/memory_storage.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+struct Position {
+    std::int16_t x;
+    std::int16_t y;
+};
+
+struct Item {
+    std::uint32_t id;
+    std::uint16_t count;
+    Position position;
+};
+
+constexpr auto properties(blob::tag<Item>) {
+    blob::properties_t<Item> props { };
+    props.member<&Item::count>().endianness = blob::endian::big;
+    return props;
+}
+
+constexpr std::size_t item_size = 10;
+
+std::vector<Item> make_items(std::size_t count) {
+    std::vector<Item> items;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto coord = static_cast<std::int16_t>(i);
+        items.push_back(Item { static_cast<std::uint32_t>(i), static_cast<std::uint16_t>(i * 100), { coord, static_cast<std::int16_t>(-coord) } });
+    }
+    return items;
+}
+
+std::vector<std::byte> serialize(const std::vector<Item>& items) {
+    std::vector<std::byte> data(items.size() * item_size);
+    blob::store_many(blob::memory_storage { data.data(), data.data(), data.data() + data.size() }, items);
+    return data;
+}
+
+/// Copyable storage that isn't contiguous, so lens_modify_many seeks between the blobs
+struct seeking_storage {
+    std::vector<std::byte>* data;
+    std::size_t position = 0;
+
+    void seek(std::ptrdiff_t num_bytes) {
+        position += num_bytes;
+    }
+
+    void load(std::byte* target, std::size_t num_bytes) {
+        if (num_bytes > data->size() - position) {
+            throw blob::storage_exhausted_exception { };
+        }
+        std::memcpy(target, data->data() + position, num_bytes);
+        position += num_bytes;
+    }
+
+    void store(std::byte* source, std::size_t num_bytes) {
+        if (num_bytes > data->size() - position) {
+            throw blob::storage_exhausted_exception { };
+        }
+        std::memcpy(data->data() + position, source, num_bytes);
+        position += num_bytes;
+    }
+};
+
+} // anonymous namespace
+
+TEST_CASE("lens_modify_many only modifies the given member") {
+    auto items = make_items(20);
+    auto data = serialize(items);
+
+    // Modify the records 5 to 14
+    auto expected = items;
+    for (std::size_t i = 5; i < 15; ++i) {
+        expected[i].count += 7;
+        expected[i].position.y *= 2;
+    }
+    const auto expected_data = serialize(expected);
+
+    auto add_count = [](std::uint16_t count) { return static_cast<std::uint16_t>(count + 7); };
+    auto double_y = [](std::int16_t y) { return static_cast<std::int16_t>(y * 2); };
+
+    SECTION("in place") {
+        auto storage = blob::memory_storage { data.data(), data.data(), data.data() + data.size() };
+        storage.seek(5 * item_size);
+        blob::lens_modify_many<&Item::count>(storage, 10, add_count);
+        blob::lens_modify_many<&Item::position, &Position::y>(storage, 10, double_y);
+        CHECK(storage.current == data.data() + 5 * item_size);
+        CHECK(data == expected_data);
+    }
+
+    SECTION("in place with bounds checking") {
+        auto storage = blob::checked_memory_storage { { data.data(), data.data(), data.data() + data.size() } };
+        storage.seek(5 * item_size);
+        CHECK_THROWS_AS(blob::lens_modify_many<&Item::count>(storage, 16, add_count), blob::storage_exhausted_exception);
+        CHECK(data == serialize(items));
+
+        blob::lens_modify_many<&Item::count>(storage, 10, add_count);
+        blob::lens_modify_many<&Item::position, &Position::y>(storage, 10, double_y);
+        CHECK(storage.current == data.data() + 5 * item_size);
+        CHECK(data == expected_data);
+    }
+
+    SECTION("seeking") {
+        seeking_storage storage { &data, 5 * item_size };
+        blob::lens_modify_many<&Item::count>(storage, 10, add_count);
+        CHECK(storage.position == 5 * item_size);
+        blob::lens_modify_many<&Item::position, &Position::y>(storage, 10, double_y);
+        CHECK(storage.position == 5 * item_size);
+        CHECK(data == expected_data);
+    }
+}
+
+TEST_CASE("lens_modify_many visits the records in order") {
+    auto data = serialize(make_items(5));
+    std::vector<std::uint32_t> visited;
+    auto visit = [&](std::uint32_t id) {
+        visited.push_back(id);
+        return id;
+    };
+
+    auto storage = blob::memory_storage { data.data(), data.data(), data.data() + data.size() };
+    blob::lens_modify_many<&Item::id>(storage, 5, visit);
+    CHECK(visited == std::vector<std::uint32_t> { 0, 1, 2, 3, 4 });
+
+    visited.clear();
+    seeking_storage seeking { &data, item_size };
+    blob::lens_modify_many<&Item::id>(seeking, 3, visit);
+    CHECK(visited == std::vector<std::uint32_t> { 1, 2, 3 });
+    CHECK(seeking.position == item_size);
+
+    blob::lens_modify_many<&Item::id>(storage, 0, visit);
+    CHECK(visited.size() == 3);
+}
@@ -0,0 +1,199 @@
+#include <blobify/blobify.hpp>
+#include <blobify/memory_storage.hpp>
+#include <blobify/stream_storage.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if __cplusplus > 201703L && __has_include(<span>)
+#include <span>
+#endif
+
+namespace {
+
+enum class Kind : std::uint8_t {
+    Audio = 1,
+    Video = 2,
+};
+
+struct Frame {
+    Kind kind;
+    std::array<std::uint16_t, 512> samples;
+    std::array<std::uint8_t, 256> label;
+    std::uint32_t sequence;
+};
+
+constexpr auto properties(blob::tag<Frame>) {
+    blob::properties_t<Frame> props { };
+    props.member<&Frame::kind>().validate_enum = true;
+    props.member<&Frame::samples>().endianness = blob::endian::big;
+    return props;
+}
+
+constexpr std::size_t frame_size = 1 + 512 * 2 + 256 + 4;
+
+constexpr auto big_endian_u32 = [] {
+    blob::element_properties_t<std::uint32_t, void> props { };
+    props.endianness = blob::endian::big;
+    return props;
+}();
+
+Frame make_frame(std::uint32_t sequence) {
+    Frame frame { };
+    frame.kind = (sequence % 2) ? Kind::Video : Kind::Audio;
+    for (std::size_t i = 0; i < frame.samples.size(); ++i) {
+        frame.samples[i] = static_cast<std::uint16_t>(sequence * 1000 + i);
+    }
+    for (std::size_t i = 0; i < frame.label.size(); ++i) {
+        frame.label[i] = static_cast<std::uint8_t>(sequence + i);
+    }
+    frame.sequence = sequence;
+    return frame;
+}
+
+/// Frame with all bytes set to a value that differs from the loaded data
+Frame make_garbage_frame() {
+    Frame frame;
+    std::fill_n(reinterpret_cast<unsigned char*>(&frame), sizeof(frame), 0xcc);
+    return frame;
+}
+
+bool operator==(const Frame& a, const Frame& b) {
+    return a.kind == b.kind && a.samples == b.samples && a.label == b.label && a.sequence == b.sequence;
+}
+
+std::vector<std::byte> serialize(std::uint32_t count) {
+    std::vector<Frame> frames;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        frames.push_back(make_frame(i));
+    }
+    std::vector<std::byte> data(count * frame_size);
+    blob::store_many(blob::memory_storage { data.data(), data.data(), data.data() + data.size() }, frames);
+    return data;
+}
+
+blob::memory_storage make_storage(std::vector<std::byte>& data) {
+    return blob::memory_storage { data.data(), data.data(), data.data() + data.size() };
+}
+
+} // anonymous namespace
+
+TEST_CASE("load_into overwrites an existing object") {
+    auto data = serialize(2);
+    auto frame = make_garbage_frame();
+    const auto* samples = frame.samples.data();
+
+    SECTION("memory") {
+        auto storage = make_storage(data);
+        blob::load_into(storage, frame);
+        CHECK(frame == make_frame(0));
+        CHECK(frame.samples.data() == samples);
+        blob::load_into(storage, frame);
+        CHECK(frame == make_frame(1));
+        CHECK(storage.current == data.data() + data.size());
+    }
+
+    SECTION("stream") {
+        std::istringstream stream { std::string(reinterpret_cast<const char*>(data.data()), data.size()) };
+        blob::istream_storage storage { { stream } };
+        blob::load_into(storage, frame);
+        blob::load_into(storage, frame);
+        CHECK(frame == make_frame(1));
+        CHECK_THROWS_AS(blob::load_into(storage, frame), blob::storage_exhausted_exception);
+    }
+
+    SECTION("validation") {
+        data[frame_size] = std::byte { 3 };
+        auto storage = make_storage(data);
+        blob::load_into(storage, frame);
+        CHECK_THROWS_AS(blob::load_into(storage, frame), blob::invalid_enum_value_exception_for<&Frame::kind>);
+    }
+}
+
+TEST_CASE("load_many_into overwrites ranges in place") {
+    auto data = serialize(4);
+
+    SECTION("std::vector") {
+        std::vector<Frame> frames(3, make_garbage_frame());
+        const auto* frames_data = frames.data();
+        auto storage = make_storage(data);
+        blob::load_many_into(storage, frames);
+        CHECK(frames.data() == frames_data);
+        CHECK(frames.size() == 3);
+        for (std::uint32_t i = 0; i < 3; ++i) {
+            CHECK(frames[i] == make_frame(i));
+        }
+        CHECK(storage.current == data.data() + 3 * frame_size);
+    }
+
+    SECTION("std::array") {
+        std::array<Frame, 4> frames;
+        frames.fill(make_garbage_frame());
+        auto storage = make_storage(data);
+        blob::load_many_into(storage, frames);
+        CHECK(frames[3] == make_frame(3));
+    }
+
+#if defined(__cpp_lib_span)
+    SECTION("std::span") {
+        std::vector<Frame> frames(4, make_garbage_frame());
+        auto storage = make_storage(data);
+        blob::load_many_into(storage, std::span { frames }.subspan(1, 2));
+        CHECK(frames[0] == make_garbage_frame());
+        CHECK(frames[1] == make_frame(0));
+        CHECK(frames[2] == make_frame(1));
+        CHECK(frames[3] == make_garbage_frame());
+    }
+#endif
+
+    SECTION("bounds checking") {
+        std::vector<Frame> frames(5, make_garbage_frame());
+        auto storage = blob::checked_memory_storage { make_storage(data) };
+        CHECK_THROWS_AS(blob::load_many_into(storage, frames), blob::storage_exhausted_exception);
+        CHECK(frames[0] == make_garbage_frame());
+    }
+
+    SECTION("validation") {
+        data[2 * frame_size] = std::byte { 0 };
+        std::vector<Frame> frames(4);
+        auto storage = make_storage(data);
+        CHECK_THROWS_AS(blob::load_many_into(storage, frames), blob::invalid_enum_value_exception_for<&Frame::kind>);
+    }
+}
+
+TEST_CASE("load_many_explicit_into overwrites elementary values") {
+    std::vector<std::uint32_t> values { 0x01020304, 0x05060708, 0x090a0b0c };
+    std::vector<std::byte> data(values.size() * 4);
+    blob::store_many_explicit<&big_endian_u32>(make_storage(data), values);
+    CHECK(data[3] == std::byte { 0x04 });
+
+    std::array<std::uint32_t, 3> loaded { 1, 2, 3 };
+    blob::load_many_explicit_into<&big_endian_u32>(make_storage(data), loaded);
+    CHECK(std::equal(loaded.begin(), loaded.end(), values.begin()));
+}
+
+TEST_CASE("load_many_into writes to output iterators") {
+    auto data = serialize(4);
+    std::vector<Frame> frames { make_garbage_frame() };
+    auto storage = make_storage(data);
+
+    auto out = blob::load_many_into<Frame>(storage, 3, std::back_inserter(frames));
+    *out = blob::load<Frame>(storage);
+    REQUIRE(frames.size() == 5);
+    CHECK(frames[0] == make_garbage_frame());
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        CHECK(frames[i + 1] == make_frame(i));
+    }
+
+    data[3 * frame_size] = std::byte { 7 };
+    storage = make_storage(data);
+    CHECK_THROWS_AS(blob::load_many_into<Frame>(storage, 4, std::back_inserter(frames)), blob::invalid_enum_value_exception_for<&Frame::kind>);
+    CHECK(frames.size() == 8);
+}
@@ -0,0 +1,94 @@
+#include <blobify/blobify.hpp>
+#include <blobify/memory_storage.hpp>
+#include <blobify/stream_storage.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Pixel {
+    std::uint8_t r;
+    std::uint8_t g;
+    std::uint8_t b;
+    std::uint16_t depth;
+    std::array<std::uint16_t, 3> weights;
+    bool visible;
+};
+
+constexpr auto properties(blob::tag<Pixel>) {
+    blob::properties_t<Pixel> props { };
+    props.member<&Pixel::depth>().endianness = blob::endian::big;
+    props.member<&Pixel::weights>().endianness = blob::endian::big;
+    return props;
+}
+
+constexpr std::size_t pixel_size = 3 + 2 + 6 + 1;
+
+std::vector<std::byte> serialize(std::size_t count) {
+    std::vector<Pixel> pixels;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto value = static_cast<std::uint16_t>(i * 257);
+        pixels.push_back(Pixel { static_cast<std::uint8_t>(i), static_cast<std::uint8_t>(i * 3), static_cast<std::uint8_t>(255 - i),
+                                 value, { value, static_cast<std::uint16_t>(value + 1), static_cast<std::uint16_t>(~value) }, (i % 3) == 0 });
+    }
+    std::vector<std::byte> data(count * pixel_size);
+    blob::store_many(blob::memory_storage { data.data(), data.data(), data.data() + data.size() }, pixels);
+    return data;
+}
+
+void check_columns(const blob::soa_columns_t<Pixel>& columns, const std::vector<Pixel>& pixels) {
+    auto& [r, g, b, depth, weights, visible] = columns;
+    REQUIRE(r.size() == pixels.size());
+    REQUIRE(g.size() == pixels.size());
+    REQUIRE(b.size() == pixels.size());
+    REQUIRE(depth.size() == pixels.size());
+    REQUIRE(weights.size() == pixels.size());
+    REQUIRE(visible.size() == pixels.size());
+    for (std::size_t i = 0; i < pixels.size(); ++i) {
+        CHECK(r[i] == pixels[i].r);
+        CHECK(g[i] == pixels[i].g);
+        CHECK(b[i] == pixels[i].b);
+        CHECK(depth[i] == pixels[i].depth);
+        CHECK(weights[i] == pixels[i].weights);
+        CHECK(visible[i] == pixels[i].visible);
+    }
+}
+
+} // anonymous namespace
+
+TEST_CASE("load_many_soa produces the columns of load_many") {
+    constexpr std::size_t count = 100;
+    auto data = serialize(count);
+    auto make_storage = [&] { return blob::checked_memory_storage { { data.data(), data.data(), data.data() + data.size() } }; };
+
+    auto storage = make_storage();
+    auto pixels = blob::load_many<std::vector<Pixel>>(storage, count);
+    CHECK(pixels[5].depth == 5 * 257);
+    CHECK(pixels[5].weights[2] == static_cast<std::uint16_t>(~(5 * 257)));
+
+    SECTION("memory") {
+        storage = make_storage();
+        check_columns(blob::load_many_soa<Pixel>(storage, count), pixels);
+        CHECK(storage.current == data.data() + data.size());
+        CHECK_THROWS_AS(blob::load_many_soa<Pixel>(storage, 1), blob::storage_exhausted_exception);
+    }
+
+    SECTION("stream") {
+        std::istringstream stream { std::string(reinterpret_cast<const char*>(data.data()), data.size()) };
+        blob::istream_storage source { { stream } };
+        check_columns(blob::load_many_soa<Pixel>(source, count - 1), std::vector<Pixel>(pixels.begin(), pixels.end() - 1));
+        CHECK_THROWS_AS(blob::load_many_soa<Pixel>(source, 2), blob::storage_exhausted_exception);
+    }
+
+    SECTION("empty") {
+        storage = make_storage();
+        check_columns(blob::load_many_soa<Pixel>(storage, 0), { });
+        CHECK(storage.current == data.data());
+    }
+}
@@ -0,0 +1,89 @@
+#include <blobify/blobify.hpp>
+#include <blobify/mmap_storage.hpp>
+#include <blobify/modify.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+struct Record {
+    std::uint32_t id;
+    std::uint16_t value;
+};
+
+/// Temporary file holding two serialized records
+struct temporary_file {
+    std::string path = "/tmp/blobify-test-" + std::to_string(::getpid());
+
+    temporary_file() {
+        blob::mmap_storage storage { path.c_str(), blob::mmap_storage::mode::read_write };
+        storage.resize(12);
+        blob::store_many(storage, std::vector<Record> { { 1, 10 }, { 2, 20 } });
+    }
+
+    ~temporary_file() {
+        std::remove(path.c_str());
+    }
+};
+
+} // anonymous namespace
+
+TEST_CASE("Read-only mappings reject stores") {
+    temporary_file file;
+    blob::mmap_storage storage { file.path.c_str() };
+    auto modify = [](auto value) { return value + 1; };
+
+    CHECK_THROWS_AS(blob::store(storage, Record { 3, 30 }), blob::storage_io_exception);
+    CHECK_THROWS_AS(blob::store_many(storage, std::vector<Record>(2)), blob::storage_io_exception);
+    CHECK_THROWS_AS(blob::lens_store<&Record::value>(storage, std::uint16_t { 30 }), blob::storage_io_exception);
+    CHECK_THROWS_AS(blob::lens_modify<&Record::value>(storage, modify), blob::storage_io_exception);
+    CHECK_THROWS_AS(blob::lens_modify_many<&Record::value>(storage, 2, modify), blob::storage_io_exception);
+    std::byte byte { };
+    CHECK_THROWS_AS(storage.store(&byte, 1), blob::storage_io_exception);
+    CHECK_THROWS_AS(storage.resize(24), blob::storage_io_exception);
+    auto result = blob::try_store(storage, Record { 3, 30 });
+    REQUIRE(!result);
+    CHECK(result.error().kind == blob::error_kind::storage_io);
+
+    CHECK(storage.position() == 0);
+    CHECK(blob::load<Record>(storage).value == 10);
+}
+
+TEST_CASE("Failed resizes keep the previous mapping") {
+    temporary_file file;
+    blob::mmap_storage storage { file.path.c_str(), blob::mmap_storage::mode::read_write };
+    storage.seek(6);
+
+    // Sizes not representable by off_t make ftruncate fail
+    CHECK_THROWS_AS(storage.resize(static_cast<std::size_t>(-1)), blob::storage_io_exception);
+    CHECK(storage.size() == 12);
+    CHECK(storage.position() == 6);
+    CHECK(blob::load<Record>(storage).id == 2);
+}
+
+TEST_CASE("Shrinking resizes clamp the cursor") {
+    temporary_file file;
+    blob::mmap_storage storage { file.path.c_str(), blob::mmap_storage::mode::read_write };
+    storage.seek(12);
+
+    storage.resize(6);
+    CHECK(storage.position() == 6);
+    CHECK(storage.remaining() == 0);
+    CHECK_THROWS_AS(blob::store(storage, Record { 3, 30 }), blob::storage_exhausted_exception);
+
+    storage.resize(0);
+    CHECK(storage.position() == 0);
+    CHECK(storage.remaining() == 0);
+    CHECK_THROWS_AS(blob::store(storage, Record { 3, 30 }), blob::storage_exhausted_exception);
+
+    storage.resize(12);
+    blob::store(storage, Record { 3, 30 });
+    CHECK(storage.position() == 6);
+}
@@ -0,0 +1,143 @@
+#include <blobify/blobify.hpp>
+#include <blobify/memory_storage.hpp>
+#include <blobify/parallel.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+enum class Kind : std::uint8_t {
+    A = 1,
+    B = 2,
+};
+
+struct Record {
+    std::uint16_t magic;
+    Kind kind;
+    std::uint32_t value;
+};
+
+constexpr auto properties(blob::tag<Record>) {
+    blob::properties_t<Record> props { };
+    props.member<&Record::magic>().expected_value = std::uint16_t { 0xb10b };
+    props.member<&Record::kind>().validate_enum = true;
+    props.member<&Record::value>().endianness = blob::endian::big;
+    return props;
+}
+
+constexpr std::size_t record_size = 7;
+
+std::vector<Record> make_records(std::size_t count) {
+    std::vector<Record> records;
+    for (std::size_t i = 0; i < count; ++i) {
+        records.push_back(Record { 0xb10b, (i % 3) ? Kind::A : Kind::B, static_cast<std::uint32_t>(i * 7) });
+    }
+    return records;
+}
+
+std::vector<std::byte> serialize(const std::vector<Record>& records) {
+    std::vector<std::byte> data(records.size() * record_size);
+    blob::store_many(blob::memory_storage { data.data(), data.data(), data.data() + data.size() }, records);
+    return data;
+}
+
+blob::checked_memory_storage make_storage(std::vector<std::byte>& data) {
+    return blob::checked_memory_storage { { data.data(), data.data(), data.data() + data.size() } };
+}
+
+bool operator==(const Record& a, const Record& b) {
+    return a.magic == b.magic && a.kind == b.kind && a.value == b.value;
+}
+
+/// Runs the tasks on the calling thread, starting with the last one
+struct reverse_executor {
+    template<typename Task>
+    void execute(std::size_t num_tasks, Task&& task) const {
+        for (std::size_t i = num_tasks; i-- > 0;) {
+            task(i);
+        }
+    }
+};
+
+} // anonymous namespace
+
+TEST_CASE("load_many_parallel") {
+    auto records = make_records(1000);
+    auto data = serialize(records);
+
+    SECTION("produces the same result as load_many") {
+        auto storage = make_storage(data);
+        auto expected = blob::load_many<std::vector<Record>>(storage, records.size());
+        REQUIRE(expected == records);
+
+        for (std::size_t num_threads : { 1, 3, 8 }) {
+            storage = make_storage(data);
+            CHECK(blob::load_many_parallel<std::vector<Record>>(storage, records.size(), num_threads) == expected);
+        }
+
+        // More chunks than elements
+        storage = make_storage(data);
+        CHECK(blob::load_many_parallel<std::vector<Record>>(storage, 5, reverse_executor { }, 16) == std::vector<Record>(records.begin(), records.begin() + 5));
+    }
+
+    SECTION("advances the cursor like load_many") {
+        auto storage = make_storage(data);
+        blob::load<Record>(storage);
+        blob::load_many_parallel<std::vector<Record>>(storage, 500, 4);
+        CHECK(storage.current == data.data() + 501 * record_size);
+        CHECK(blob::load<Record>(storage).value == 501 * 7);
+
+        blob::load_many_parallel<std::vector<Record>>(storage, 498, 4);
+        CHECK_THROWS_AS(blob::load_many_parallel<std::vector<Record>>(storage, 1, 4), blob::storage_exhausted_exception);
+    }
+
+    SECTION("rethrows the exception of the first invalid element") {
+        // The invalid elements end up in the second and the last of 8 chunks
+        data[200 * record_size] = std::byte { 0 };
+        data[950 * record_size + 2] = std::byte { 7 };
+
+        auto storage = make_storage(data);
+        CHECK_THROWS_AS(blob::load_many<std::vector<Record>>(storage, records.size()),
+                        blob::unexpected_value_exception<&Record::magic>);
+
+        // The last chunk fails first
+        storage = make_storage(data);
+        CHECK_THROWS_AS(blob::load_many_parallel<std::vector<Record>>(storage, records.size(), reverse_executor { }, 8),
+                        blob::unexpected_value_exception<&Record::magic>);
+
+        storage = make_storage(data);
+        CHECK_THROWS_AS(blob::load_many_parallel<std::vector<Record>>(storage, records.size(), 8),
+                        blob::unexpected_value_exception<&Record::magic>);
+
+        // Only the later chunk is invalid
+        data[200 * record_size] = std::byte { 0x0b };
+        storage = make_storage(data);
+        CHECK_THROWS_AS(blob::load_many_parallel<std::vector<Record>>(storage, records.size(), reverse_executor { }, 8),
+                        blob::invalid_enum_value_exception_for<&Record::kind>);
+    }
+}
+
+TEST_CASE("store_many_parallel round-trips data") {
+    auto records = make_records(1000);
+    auto expected = serialize(records);
+
+    for (std::size_t num_threads : { 1, 3, 8 }) {
+        std::vector<std::byte> data(expected.size());
+        auto storage = make_storage(data);
+        blob::store_many_parallel(storage, records, num_threads);
+        CHECK(data == expected);
+        CHECK(storage.current == data.data() + data.size());
+        CHECK_THROWS_AS(blob::store_many_parallel(storage, records, num_threads), blob::storage_exhausted_exception);
+
+        storage = make_storage(data);
+        CHECK(blob::load_many_parallel<std::vector<Record>>(storage, records.size(), num_threads) == records);
+    }
+
+    std::vector<std::byte> data(expected.size());
+    auto storage = make_storage(data);
+    blob::store_many_parallel(storage, records, reverse_executor { }, 7);
+    CHECK(data == expected);
+}
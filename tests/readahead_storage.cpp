@@ -0,0 +1,133 @@
+#include <blobify/blobify.hpp>
+#include <blobify/readahead_storage.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace {
+
+struct Record {
+    std::uint32_t index;
+    std::uint16_t value;
+};
+
+constexpr std::size_t record_size = 6;
+
+// Doesn't divide the record size, so records straddle block boundaries
+constexpr std::size_t block_size = 16;
+
+/// In-memory storage that counts seeks and fails reads past a given offset
+struct test_source {
+    std::vector<std::byte> data;
+    std::size_t position = 0;
+    std::size_t error_offset = std::numeric_limits<std::size_t>::max();
+
+    // Only accessed by the loading thread, since readahead_storage pauses the background thread for seeks
+    std::size_t num_seeks = 0;
+
+    explicit test_source(std::size_t num_records) : data(num_records * record_size) {
+        for (std::size_t i = 0; i < num_records; ++i) {
+            auto storage = blob::memory_storage { data.data() + i * record_size, data.data(), data.data() + data.size() };
+            blob::store(storage, Record { static_cast<std::uint32_t>(i), static_cast<std::uint16_t>(i * 3) });
+        }
+    }
+
+    std::size_t read_some(std::byte* target, std::size_t max_bytes) {
+        if (position >= error_offset) {
+            throw blob::storage_io_exception { EIO };
+        }
+        auto num_bytes = std::min({ max_bytes, data.size() - position, error_offset - position });
+        std::memcpy(target, data.data() + position, num_bytes);
+        position += num_bytes;
+        return num_bytes;
+    }
+
+    void seek(std::ptrdiff_t num_bytes) {
+        ++num_seeks;
+        position += num_bytes;
+    }
+};
+
+} // anonymous namespace
+
+TEST_CASE("readahead_storage loads across block boundaries") {
+    test_source source { 100 };
+    blob::readahead_storage storage { source, block_size, 3 };
+
+    auto records = blob::load_many<std::vector<Record>>(storage, 100);
+    for (std::uint32_t i = 0; i < 100; ++i) {
+        REQUIRE(records[i].index == i);
+        REQUIRE(records[i].value == i * 3);
+    }
+    CHECK_THROWS_AS(blob::load<Record>(storage), blob::storage_exhausted_exception);
+    CHECK(source.num_seeks == 0);
+}
+
+TEST_CASE("readahead_storage seeks") {
+    test_source source { 100 };
+    blob::readahead_storage storage { source, block_size, 3 };
+
+    SECTION("forward within the buffered blocks") {
+        CHECK(blob::load<Record>(storage).index == 0);
+        storage.seek(record_size);
+        CHECK(blob::load<Record>(storage).index == 2);
+        CHECK(source.num_seeks == 0);
+
+        // The target may or may not have been read ahead already
+        storage.seek(3 * record_size);
+        CHECK(blob::load<Record>(storage).index == 6);
+        CHECK(blob::load<Record>(storage).index == 7);
+    }
+
+    SECTION("backward outside the buffered blocks") {
+        blob::load_many<std::vector<Record>>(storage, 50);
+        storage.seek(-static_cast<std::ptrdiff_t>(50 * record_size));
+        CHECK(source.num_seeks == 1);
+        CHECK(blob::load<Record>(storage).index == 0);
+
+        auto records = blob::load_many<std::vector<Record>>(storage, 99);
+        CHECK(records.back().index == 99);
+        CHECK(records.back().value == 297);
+    }
+
+    SECTION("forward past the end of the buffered blocks") {
+        CHECK(blob::load<Record>(storage).index == 0);
+        storage.seek(80 * record_size);
+        CHECK(blob::load<Record>(storage).index == 81);
+    }
+}
+
+TEST_CASE("readahead_storage stops at the end of a partially filled block") {
+    // The last of the four blocks holds 12 bytes
+    test_source source { 10 };
+    blob::readahead_storage storage { source, block_size, 2 };
+
+    std::vector<std::byte> buffer(100);
+    CHECK(storage.read_some(buffer.data(), 3) == 3);
+    CHECK(storage.read_some(buffer.data(), buffer.size()) == 10 * record_size - 3);
+    CHECK(std::equal(buffer.begin(), buffer.begin() + 10 * record_size - 3, source.data.begin() + 3));
+    CHECK(storage.read_some(buffer.data(), buffer.size()) == 0);
+
+    storage.seek(-static_cast<std::ptrdiff_t>(2 * record_size));
+    CHECK(blob::load<Record>(storage).index == 8);
+    CHECK(blob::load<Record>(storage).index == 9);
+    CHECK_THROWS_AS(blob::load<Record>(storage), blob::storage_exhausted_exception);
+}
+
+TEST_CASE("readahead_storage rethrows read errors after the buffered data") {
+    test_source source { 100 };
+    source.error_offset = 3 * block_size + 4;
+    blob::readahead_storage storage { source, block_size, 2 };
+
+    // Data read before the error is still delivered
+    auto records = blob::load_many<std::vector<Record>>(storage, 8);
+    CHECK(records.back().index == 7);
+    CHECK(records.back().value == 21);
+    CHECK_THROWS_AS(blob::load<Record>(storage), blob::storage_io_exception);
+}
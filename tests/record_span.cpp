@@ -0,0 +1,142 @@
+#include <blobify/blobify.hpp>
+#include <blobify/memory_storage.hpp>
+#include <blobify/record_span.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+struct Point {
+    std::int16_t x;
+    std::int16_t y;
+};
+
+struct Line {
+    std::uint8_t layer;
+    Point from;
+    Point to;
+    std::uint32_t color;
+};
+
+constexpr auto properties(blob::tag<Line>) {
+    blob::properties_t<Line> props { };
+    props.member<&Line::color>().endianness = blob::endian::big;
+    return props;
+}
+
+constexpr std::size_t line_size = 1 + 4 + 4 + 4;
+
+Line make_line(std::size_t i) {
+    auto coord = static_cast<std::int16_t>(i);
+    return Line { static_cast<std::uint8_t>(i), { coord, static_cast<std::int16_t>(-coord) }, { static_cast<std::int16_t>(2 * coord), 0 },
+                  static_cast<std::uint32_t>(i * 0x01010101) };
+}
+
+std::vector<std::byte> serialize(std::size_t count) {
+    std::vector<Line> lines;
+    for (std::size_t i = 0; i < count; ++i) {
+        lines.push_back(make_line(i));
+    }
+    std::vector<std::byte> data(count * line_size);
+    blob::store_many(blob::memory_storage { data.data(), data.data(), data.data() + data.size() }, lines);
+    return data;
+}
+
+} // anonymous namespace
+
+TEST_CASE("record_span decodes records on access") {
+    auto data = serialize(10);
+    blob::record_span<Line> lines { data.data(), 10 };
+    static_assert(decltype(lines)::record_size == line_size);
+    CHECK(lines.size() == 10);
+    CHECK(!lines.empty());
+    CHECK(lines.data() == data.data());
+
+    SECTION("whole records") {
+        Line line = lines[3];
+        CHECK(line.layer == 3);
+        CHECK(line.from.y == -3);
+        CHECK(line.color == 0x03030303);
+        CHECK(lines.load(9).to.x == 18);
+        CHECK(lines[9].data() == data.data() + 9 * line_size);
+    }
+
+    SECTION("members") {
+        CHECK(lines[4].get<&Line::color>() == 0x04040404);
+        CHECK(lines[4].get<&Line::from, &Point::y>() == -4);
+        CHECK(lines.get<&Line::to, &Point::x>(7) == 14);
+        CHECK(lines.get<&Line::layer>(0) == 0);
+    }
+
+    SECTION("at") {
+        CHECK(lines.at(9).get<&Line::layer>() == 9);
+        CHECK_THROWS_AS(lines.at(10), std::out_of_range);
+        CHECK_THROWS_AS(blob::record_span<Line>(data.data(), 0).at(0), std::out_of_range);
+    }
+}
+
+TEST_CASE("record_span iterators") {
+    auto data = serialize(10);
+    blob::record_span<Line> lines { data.data(), 10 };
+
+    CHECK(lines.end() - lines.begin() == 10);
+    CHECK(std::distance(lines.begin(), lines.end()) == 10);
+
+    auto it = lines.begin();
+    CHECK((*it).get<&Line::layer>() == 0);
+    CHECK((*++it).get<&Line::layer>() == 1);
+    CHECK((*it++).get<&Line::layer>() == 1);
+    CHECK(it[3].get<&Line::layer>() == 5);
+    it += 6;
+    CHECK((*it).get<&Line::layer>() == 8);
+    CHECK((*(it - 3)).get<&Line::layer>() == 5);
+    CHECK((*(2 + lines.begin())).get<&Line::layer>() == 2);
+    CHECK((*it--).get<&Line::layer>() == 8);
+    it -= 2;
+    CHECK((*it).get<&Line::layer>() == 5);
+    CHECK(lines.end() - it == 5);
+
+    CHECK(lines.begin() < it);
+    CHECK(it <= it);
+    CHECK(lines.end() > it);
+    CHECK(it >= lines.begin());
+    CHECK(it != lines.end());
+    CHECK(it + 5 == lines.end());
+
+    std::vector<Line> loaded(lines.begin(), lines.end());
+    REQUIRE(loaded.size() == 10);
+    CHECK(loaded[6].color == 0x06060606);
+
+    auto found = std::find_if(lines.begin(), lines.end(), [](auto line) { return line.template get<&Line::from, &Point::x>() == 7; });
+    CHECK(found - lines.begin() == 7);
+}
+
+TEST_CASE("record_span on storages") {
+    auto data = serialize(10);
+
+    SECTION("starts at the storage cursor") {
+        auto storage = blob::memory_storage { data.data(), data.data(), data.data() + data.size() };
+        storage.seek(2 * line_size);
+        blob::record_span<Line> lines { storage, 8 };
+        CHECK(lines[0].get<&Line::layer>() == 2);
+        CHECK(lines.data() == data.data() + 2 * line_size);
+
+        // The cursor is not advanced
+        CHECK(storage.current == data.data() + 2 * line_size);
+    }
+
+    SECTION("checks the bounds of checked_memory_storage") {
+        auto storage = blob::checked_memory_storage { { data.data(), data.data(), data.data() + data.size() } };
+        CHECK(blob::record_span<Line>(storage, 10).size() == 10);
+        CHECK_THROWS_AS(blob::record_span<Line>(storage, 11), blob::storage_exhausted_exception);
+
+        storage.seek(line_size + 1);
+        CHECK_THROWS_AS(blob::record_span<Line>(storage, 9), blob::storage_exhausted_exception);
+        CHECK(blob::record_span<Line>(storage, 8)[0].data() == data.data() + line_size + 1);
+    }
+}
@@ -0,0 +1,96 @@
+#include <blobify/blobify.hpp>
+#include <blobify/memory_storage.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+struct Point {
+    std::uint32_t x;
+    std::uint16_t y;
+    std::array<std::uint8_t, 3> z;
+};
+
+constexpr std::size_t point_size = 4 + 2 + 3;
+
+// Big-endian members are byte-swapped directly into contiguous storages
+struct Samples {
+    std::uint8_t num_samples;
+    std::array<float, 4> scale;
+    std::vector<std::uint8_t> samples;
+};
+
+constexpr auto properties(blob::tag<Samples>) {
+    blob::properties_t<Samples> props { };
+    props.member<&Samples::scale>().endianness = blob::endian::big;
+    props.member<&Samples::samples>().count_member<&Samples::num_samples>();
+    return props;
+}
+
+blob::checked_memory_storage make_storage(std::vector<std::byte>& buffer, std::size_t size) {
+    return blob::checked_memory_storage { { buffer.data(), buffer.data(), buffer.data() + size } };
+}
+
+} // anonymous namespace
+
+TEST_CASE("Checked storages reject out-of-bounds accesses") {
+    std::vector<std::byte> buffer(4 * point_size);
+    const Point point { 1, 2, { 3, 4, 5 } };
+
+    SECTION("exact fit") {
+        auto target = make_storage(buffer, point_size);
+        blob::store(target, point);
+        CHECK(target.remaining() == 0);
+
+        auto source = make_storage(buffer, point_size);
+        CHECK(blob::load<Point>(source).z[2] == 5);
+        CHECK(source.remaining() == 0);
+    }
+
+    SECTION("single records") {
+        auto target = make_storage(buffer, point_size - 1);
+        CHECK_THROWS_AS(blob::store(target, point), blob::storage_exhausted_exception);
+        CHECK(target.current == buffer.data());
+
+        auto source = make_storage(buffer, point_size - 1);
+        CHECK_THROWS_AS(blob::load<Point>(source), blob::storage_exhausted_exception);
+        CHECK(source.current == buffer.data());
+    }
+
+    SECTION("many records") {
+        std::vector<Point> points(4, point);
+        auto target = make_storage(buffer, 4 * point_size - 1);
+        CHECK_THROWS_AS(blob::store_many(target, points), blob::storage_exhausted_exception);
+
+        auto source = make_storage(buffer, 4 * point_size - 1);
+        CHECK_THROWS_AS(blob::load_many<std::vector<Point>>(source, 4), blob::storage_exhausted_exception);
+    }
+
+    SECTION("variable-length records") {
+        // The size of Samples isn't known statically, so each member is checked individually
+        const Samples samples { 2, { 1.f, 2.f, 3.f, 4.f }, { 6, 7 } };
+        auto target = make_storage(buffer, 6);
+        CHECK_THROWS_AS(blob::store(target, samples), blob::storage_exhausted_exception);
+        CHECK(std::all_of(buffer.begin() + 6, buffer.end(), [](std::byte b) { return b == std::byte { 0 }; }));
+
+        target = make_storage(buffer, 1 + 16 + 2);
+        blob::store(target, samples);
+        CHECK(target.remaining() == 0);
+
+        auto source = make_storage(buffer, 1 + 16 + 2);
+        auto loaded = blob::load<Samples>(source);
+        CHECK(loaded.scale == samples.scale);
+        CHECK(loaded.samples == samples.samples);
+    }
+
+    SECTION("seeks") {
+        auto storage = make_storage(buffer, point_size);
+        CHECK_THROWS_AS(storage.seek(point_size + 1), blob::storage_exhausted_exception);
+        CHECK_THROWS_AS(storage.seek(-1), blob::storage_exhausted_exception);
+    }
+}
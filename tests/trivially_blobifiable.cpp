@@ -0,0 +1,91 @@
+#include <blobify/blobify.hpp>
+#include <blobify/memory_storage.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+constexpr auto non_native_endian = (blob::endian::native == blob::endian::little) ? blob::endian::big : blob::endian::little;
+
+struct Packed {
+    std::uint32_t a;
+    std::uint16_t b;
+    std::uint16_t c;
+};
+
+struct Padded {
+    std::uint8_t a;
+    std::uint32_t b;
+};
+
+struct Expected {
+    std::uint32_t magic;
+    std::uint32_t value;
+};
+
+constexpr auto properties(blob::tag<Expected>) {
+    blob::properties_t<Expected> props { };
+    props.member<&Expected::magic>().expected_value = std::uint32_t { 0x424c4f42 };
+    return props;
+}
+
+struct Swapped {
+    std::uint32_t a;
+    std::uint32_t b;
+};
+
+constexpr auto properties(blob::tag<Swapped>) {
+    blob::properties_t<Swapped> props { };
+    props.member<&Swapped::b>().endianness = non_native_endian;
+    return props;
+}
+
+// The bit-field spans an entire word, so the serialized size matches the in-memory size
+struct BitField {
+    std::uint8_t flags;
+    std::uint8_t value;
+};
+
+constexpr auto properties(blob::tag<BitField>) {
+    blob::properties_t<BitField> props { };
+    props.member<&BitField::flags>().bit_width = 8;
+    return props;
+}
+
+struct Nested {
+    Packed packed;
+    std::array<std::uint16_t, 4> values;
+};
+
+struct NestedSwapped {
+    std::uint32_t a;
+    Swapped swapped;
+};
+
+} // anonymous namespace
+
+static_assert(blob::is_trivially_blobifiable_v<Packed>);
+static_assert(blob::is_trivially_blobifiable_v<Nested>);
+static_assert(blob::is_trivially_blobifiable_v<std::array<Packed, 3>>);
+
+static_assert(!blob::is_trivially_blobifiable_v<Padded>, "Padding isn't part of the serialized data");
+static_assert(!blob::is_trivially_blobifiable_v<Expected>, "expected_value must be checked on load");
+static_assert(!blob::is_trivially_blobifiable_v<Swapped>, "Non-native endianness requires byte swapping");
+static_assert(!blob::is_trivially_blobifiable_v<BitField>, "Bit-fields require packing");
+static_assert(!blob::is_trivially_blobifiable_v<NestedSwapped>, "Nested aggregates must be trivially blobifiable too");
+static_assert(!blob::is_trivially_blobifiable_v<std::array<Swapped, 3>>);
+
+// Data that has been validated before can be copied despite expected_value
+static_assert(blob::detail::is_trivially_blobifiable_element<Expected, &blob::detail::properties_for<Expected>, false>());
+static_assert(!blob::detail::is_trivially_blobifiable_element<Swapped, &blob::detail::properties_for<Swapped>, false>());
+
+TEST_CASE("Trivially blobifiable aggregates are copied as a whole") {
+    const Nested nested { { 1, 2, 3 }, { 4, 5, 6, 7 } };
+    std::byte buffer[sizeof(Nested)];
+    blob::store(blob::memory_storage { buffer, buffer, buffer + sizeof(buffer) }, nested);
+    CHECK(std::memcmp(buffer, &nested, sizeof(nested)) == 0);
+}
@@ -0,0 +1,172 @@
+#include <blobify/blobify.hpp>
+#include <blobify/memory_storage.hpp>
+#include <blobify/stream_storage.hpp>
+#include <blobify/try_load.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+enum class Kind : std::uint8_t {
+    A = 1,
+    B = 2,
+    C = 5,
+};
+
+// Only validated, so checked records can be copied as a whole
+struct Record {
+    Kind kind;
+    std::uint8_t tag;
+    std::uint16_t value;
+};
+
+constexpr auto properties(blob::tag<Record>) {
+    blob::properties_t<Record> props { };
+    props.member<&Record::kind>().validate_enum = true;
+    props.member<&Record::tag>().expected_value = std::uint8_t { 0x7f };
+    return props;
+}
+
+// Checked records are still byte-swapped when decoding them
+struct SwappedRecord {
+    Kind kind;
+    std::uint8_t tag;
+    std::uint16_t value;
+};
+
+constexpr auto properties(blob::tag<SwappedRecord>) {
+    blob::properties_t<SwappedRecord> props { };
+    props.member<&SwappedRecord::kind>().validate_enum = true;
+    props.member<&SwappedRecord::value>().endianness = blob::endian::big;
+    return props;
+}
+
+constexpr std::size_t record_size = 4;
+
+struct Message {
+    std::uint8_t length;
+    std::vector<std::uint8_t> payload;
+    std::vector<std::uint16_t> checksums;
+};
+
+constexpr auto properties(blob::tag<Message>) {
+    blob::properties_t<Message> props { };
+    props.member<&Message::payload>().count_member<&Message::length>();
+    props.member<&Message::checksums>().count_member<&Message::length>();
+    return props;
+}
+
+std::vector<std::byte> make_records(std::initializer_list<std::uint8_t> kinds) {
+    std::vector<std::byte> ret;
+    std::uint8_t index = 0;
+    for (auto kind : kinds) {
+        for (auto byte : { kind, std::uint8_t { 0x7f }, std::uint8_t { 0x10 }, index++ }) {
+            ret.push_back(std::byte { byte });
+        }
+    }
+    return ret;
+}
+
+blob::memory_storage make_storage(std::vector<std::byte>& buffer) {
+    return blob::memory_storage { buffer.data(), buffer.data(), buffer.data() + buffer.size() };
+}
+
+} // anonymous namespace
+
+TEST_CASE("try_load_many decodes checked records") {
+    auto buffer = make_records({ 1, 2, 5, 1 });
+
+    SECTION("contiguous storage") {
+        auto storage = make_storage(buffer);
+        auto records = blob::try_load_many<std::vector<Record>>(storage, 4);
+        REQUIRE(records);
+        CHECK((*records)[2].kind == Kind::C);
+        CHECK((*records)[3].value == 0x0310);
+        CHECK(storage.current == buffer.data() + buffer.size());
+
+        auto swapped = make_storage(buffer);
+        auto swapped_records = blob::try_load_many<std::vector<SwappedRecord>>(swapped, 4);
+        REQUIRE(swapped_records);
+        CHECK((*swapped_records)[3].value == 0x1003);
+    }
+
+    SECTION("stream storage") {
+        std::stringstream stream { std::string { reinterpret_cast<const char*>(buffer.data()), buffer.size() } };
+        auto records = blob::try_load_many<std::vector<SwappedRecord>>(blob::istream_storage { { stream } }, 4);
+        REQUIRE(records);
+        CHECK((*records)[2].kind == Kind::C);
+        CHECK((*records)[3].value == 0x1003);
+    }
+
+    SECTION("single record") {
+        auto storage = make_storage(buffer);
+        storage.seek(2 * record_size);
+        auto record = blob::try_load<Record>(storage);
+        REQUIRE(record);
+        CHECK(record->kind == Kind::C);
+        CHECK(record->value == 0x0210);
+    }
+}
+
+TEST_CASE("try_load_many reports the first invalid record") {
+    auto buffer = make_records({ 1, 2, 3, 4 });
+
+    SECTION("contiguous storage") {
+        auto storage = make_storage(buffer);
+        auto records = blob::try_load_many<std::vector<Record>>(storage, 4);
+        REQUIRE(!records);
+        CHECK(records.error().kind == blob::error_kind::invalid_enum_value);
+        CHECK(records.error().byte_offset == 2 * record_size);
+        CHECK(records.error().actual == 3);
+        CHECK(storage.current == buffer.data() + 3 * record_size);
+    }
+
+    SECTION("stream storage") {
+        std::stringstream stream { std::string { reinterpret_cast<const char*>(buffer.data()), buffer.size() } };
+        auto records = blob::try_load_many<std::vector<Record>>(blob::istream_storage { { stream } }, 4);
+        REQUIRE(!records);
+        CHECK(records.error().byte_offset == 2 * record_size);
+    }
+
+    SECTION("unexpected value") {
+        buffer[record_size + 1] = std::byte { 0 };
+        auto storage = make_storage(buffer);
+        auto records = blob::try_load_many<std::vector<Record>>(storage, 2);
+        REQUIRE(!records);
+        CHECK(records.error().kind == blob::error_kind::unexpected_value);
+        CHECK(records.error().member_index == 1);
+        CHECK(records.error().expected == 0x7f);
+    }
+}
+
+TEST_CASE("try_store reports failures") {
+    std::vector<std::byte> buffer(2 * record_size);
+
+    SECTION("storage exhausted") {
+        blob::checked_memory_storage storage { make_storage(buffer) };
+        CHECK(blob::try_store(storage, Record { Kind::A, 0x7f, 1 }));
+        CHECK(blob::try_store(storage, Record { Kind::A, 0x7f, 2 }));
+        auto result = blob::try_store(storage, Record { Kind::A, 0x7f, 3 });
+        REQUIRE(!result);
+        CHECK(result.error().kind == blob::error_kind::storage_exhausted);
+    }
+
+    SECTION("invalid length") {
+        std::vector<std::byte> message_buffer(1024);
+        blob::checked_memory_storage storage { make_storage(message_buffer) };
+        auto result = blob::try_store(storage, Message { 0, { 1, 2 }, { 3 } });
+        REQUIRE(!result);
+        CHECK(result.error().kind == blob::error_kind::invalid_length);
+        CHECK(result.error().actual == 1);
+
+        result = blob::try_store(storage, Message { 0, std::vector<std::uint8_t>(256), std::vector<std::uint16_t>(256) });
+        REQUIRE(!result);
+        CHECK(result.error().kind == blob::error_kind::invalid_length);
+        CHECK(result.error().actual == 256);
+    }
+}
@@ -0,0 +1,119 @@
+#include <blobify/blobify.hpp>
+#include <blobify/stream_storage.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Record {
+    std::uint32_t index;
+    std::uint16_t value;
+};
+
+constexpr std::size_t record_size = 6;
+
+// Larger than the amount of data type_erased_storage reads through its buffer
+struct Chunk {
+    std::array<std::uint8_t, 4000> data;
+};
+
+std::vector<Record> make_records(std::size_t count) {
+    std::vector<Record> records;
+    for (std::size_t i = 0; i < count; ++i) {
+        records.push_back(Record { static_cast<std::uint32_t>(i), static_cast<std::uint16_t>(i * 5) });
+    }
+    return records;
+}
+
+std::string serialize(const std::vector<Record>& records) {
+    std::ostringstream stream;
+    blob::ostream_storage target { { stream } };
+    blob::store_many(target, records);
+    return stream.str();
+}
+
+/// type_erased_storage reading from an istream_storage
+struct stream_source {
+    std::istringstream stream;
+    blob::istream_storage storage { { stream } };
+    blob::runtime_storage_adapter<blob::istream_storage&> adapter { storage };
+    blob::type_erased_storage erased { adapter };
+
+    explicit stream_source(std::string data) : stream(std::move(data)) {
+    }
+};
+
+} // anonymous namespace
+
+TEST_CASE("type_erased_storage round-trips data") {
+    auto records = make_records(2000);
+    Chunk chunk;
+    for (std::size_t i = 0; i < chunk.data.size(); ++i) {
+        chunk.data[i] = static_cast<std::uint8_t>(i * 7);
+    }
+
+    std::ostringstream output;
+    {
+        blob::ostream_storage target { { output } };
+        blob::runtime_storage_adapter<blob::ostream_storage&> adapter { target };
+        blob::type_erased_storage erased { adapter };
+        blob::store_many(erased, records);
+        blob::store(erased, chunk);
+        blob::store(erased, records[3]);
+    }
+    CHECK(output.str().size() == records.size() * record_size + sizeof(chunk.data) + record_size);
+    CHECK(output.str().substr(0, records.size() * record_size) == serialize(records));
+
+    stream_source source { output.str() };
+    CHECK(blob::load_many<std::vector<Record>>(source.erased, records.size()).back().value == 1999 * 5);
+    // Bypasses the buffer
+    CHECK(blob::load<Chunk>(source.erased).data == chunk.data);
+    CHECK(blob::load<Record>(source.erased).index == 3);
+    CHECK_THROWS_AS(blob::load<Record>(source.erased), blob::storage_exhausted_exception);
+}
+
+TEST_CASE("type_erased_storage seeks") {
+    // istream_storage can't seek backwards, so backward seeks must be served from the buffer
+    stream_source source { serialize(make_records(2000)) };
+    auto& storage = source.erased;
+
+    SECTION("before the first load") {
+        storage.seek(10 * record_size);
+        CHECK(blob::load<Record>(storage).index == 10);
+        storage.seek(-static_cast<std::ptrdiff_t>(6 * record_size));
+        CHECK(blob::load<Record>(storage).index == 5);
+    }
+
+    SECTION("backward into the history") {
+        // Refills the buffer several times
+        CHECK(blob::load_many<std::vector<Record>>(storage, 700).back().index == 699);
+        storage.seek(-static_cast<std::ptrdiff_t>(150 * record_size));
+        CHECK(blob::load<Record>(storage).index == 550);
+        CHECK(blob::lens_load<&Record::value>(storage) == 551 * 5);
+        CHECK(blob::load<Record>(storage).index == 551);
+    }
+
+    SECTION("forward past the buffered data") {
+        CHECK(blob::load_many<std::vector<Record>>(storage, 600).back().index == 599);
+        storage.seek(400 * record_size);
+        CHECK(blob::load<Record>(storage).index == 1000);
+
+        // The skipped data has been read into the buffer
+        storage.seek(-static_cast<std::ptrdiff_t>(100 * record_size));
+        CHECK(blob::load<Record>(storage).index == 901);
+    }
+
+    SECTION("past the buffer") {
+        CHECK(blob::load<Record>(storage).index == 0);
+        storage.seek(1000 * record_size);
+        CHECK(blob::load<Record>(storage).index == 1001);
+        CHECK(blob::load_many<std::vector<Record>>(storage, 998).back().index == 1999);
+        CHECK_THROWS_AS(blob::load<Record>(storage), blob::storage_exhausted_exception);
+    }
+}
@@ -0,0 +1,172 @@
+#include <blobify/blobify.hpp>
+#include <blobify/memory_storage.hpp>
+#include <blobify/stream_storage.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+struct Entry {
+    std::uint16_t id;
+    std::uint32_t offset;
+};
+
+struct Table {
+    std::uint32_t num_entries;
+    std::vector<Entry> entries;
+    std::uint8_t trailer;
+};
+
+constexpr auto properties(blob::tag<Table>) {
+    blob::properties_t<Table> props { };
+    props.member<&Table::entries>().count_member<&Table::num_entries>();
+    return props;
+}
+
+// Several members sharing a single count member
+struct Columns {
+    std::uint8_t length;
+    std::string name;
+    std::vector<std::uint16_t> values;
+    std::vector<bool> flags;
+};
+
+constexpr auto properties(blob::tag<Columns>) {
+    blob::properties_t<Columns> props { };
+    props.member<&Columns::name>().count_member<&Columns::length>();
+    props.member<&Columns::values>().count_member<&Columns::length>().endianness = blob::endian::big;
+    props.member<&Columns::flags>().count_member<&Columns::length>();
+    return props;
+}
+
+struct Label {
+    std::int16_t length;
+    std::string_view text;
+};
+
+constexpr auto properties(blob::tag<Label>) {
+    blob::properties_t<Label> props { };
+    props.member<&Label::text>().count_member<&Label::length>();
+    return props;
+}
+
+std::istringstream make_stream(const std::vector<std::byte>& data, std::size_t size) {
+    return std::istringstream { std::string { reinterpret_cast<const char*>(data.data()), size } };
+}
+
+const Table table { 0, { { 1, 10 }, { 2, 20 }, { 3, 30 } }, 0x7f };
+constexpr std::size_t table_size = 4 + 3 * 6 + 1;
+
+} // anonymous namespace
+
+TEST_CASE("Variable-length members round-trip") {
+    std::vector<std::byte> buffer(256);
+
+    blob::memory_storage target { buffer.data(), buffer.data(), buffer.data() + buffer.size() };
+    blob::store(target, table);
+    REQUIRE(target.current == buffer.data() + table_size);
+
+    SECTION("checked memory") {
+        blob::checked_memory_storage source { { buffer.data(), buffer.data(), buffer.data() + table_size } };
+        auto loaded = blob::load<Table>(source);
+        CHECK(loaded.num_entries == 3);
+        REQUIRE(loaded.entries.size() == 3);
+        CHECK(loaded.entries[2].id == 3);
+        CHECK(loaded.entries[2].offset == 30);
+        CHECK(loaded.trailer == 0x7f);
+        CHECK(source.remaining() == 0);
+    }
+
+    SECTION("stream") {
+        auto stream = make_stream(buffer, table_size);
+        blob::istream_storage source { { stream } };
+        auto loaded = blob::load<Table>(source);
+        REQUIRE(loaded.entries.size() == 3);
+        CHECK(loaded.entries[1].offset == 20);
+        CHECK(loaded.trailer == 0x7f);
+    }
+
+    SECTION("many") {
+        std::vector<Table> tables { table, table };
+        tables[1].entries.pop_back();
+        blob::memory_storage many_target { buffer.data(), buffer.data(), buffer.data() + buffer.size() };
+        blob::store_many(many_target, tables);
+
+        blob::checked_memory_storage source { { buffer.data(), buffer.data(), many_target.current } };
+        auto loaded = blob::load_many<std::vector<Table>>(source, 2);
+        CHECK(loaded[0].entries.size() == 3);
+        CHECK(loaded[1].num_entries == 2);
+        CHECK(loaded[1].trailer == 0x7f);
+    }
+}
+
+TEST_CASE("Variable-length members sharing a count member") {
+    std::vector<std::byte> buffer(64);
+    Columns columns { 0, "abc", { 0x102, 0x304, 5 }, { true, false, true } };
+    blob::memory_storage target { buffer.data(), buffer.data(), buffer.data() + buffer.size() };
+    blob::store(target, columns);
+    CHECK(target.current == buffer.data() + 1 + 3 + 6 + 3);
+    CHECK(buffer[0] == std::byte { 3 });
+    CHECK(buffer[4] == std::byte { 1 }); // Big-endian 0x102
+
+    auto loaded = blob::load<Columns>(blob::memory_storage { buffer.data(), buffer.data(), buffer.data() + buffer.size() });
+    CHECK(loaded.name == "abc");
+    CHECK(loaded.values == columns.values);
+    CHECK(loaded.flags == columns.flags);
+
+    SECTION("mismatching sizes are rejected on store") {
+        columns.values.push_back(6);
+        blob::memory_storage mismatch_target { buffer.data(), buffer.data(), buffer.data() + buffer.size() };
+        CHECK_THROWS_AS(blob::store(mismatch_target, columns), blob::invalid_length_exception);
+    }
+}
+
+TEST_CASE("View members refer to the loaded memory") {
+    std::vector<std::byte> buffer { std::byte { 2 }, std::byte { 0 }, std::byte { 'h' }, std::byte { 'i' } };
+    auto loaded = blob::load<Label>(blob::memory_storage { buffer.data(), buffer.data(), buffer.data() + buffer.size() });
+    CHECK(loaded.text == "hi");
+    CHECK(reinterpret_cast<const std::byte*>(loaded.text.data()) == buffer.data() + 2);
+
+    SECTION("negative counts are rejected") {
+        buffer[1] = std::byte { 0xff };
+        blob::memory_storage source { buffer.data(), buffer.data(), buffer.data() + buffer.size() };
+        CHECK_THROWS_AS(blob::load<Label>(source), blob::invalid_length_exception);
+    }
+}
+
+TEST_CASE("Variable-length members with truncated data") {
+    std::vector<std::byte> buffer(256);
+    blob::store(blob::memory_storage { buffer.data(), buffer.data(), buffer.data() + buffer.size() }, table);
+
+    SECTION("checked memory") {
+        blob::checked_memory_storage source { { buffer.data(), buffer.data(), buffer.data() + table_size - 1 } };
+        CHECK_THROWS_AS(blob::load<Table>(source), blob::storage_exhausted_exception);
+    }
+
+    SECTION("stream") {
+        auto stream = make_stream(buffer, table_size - 1);
+        blob::istream_storage source { { stream } };
+        CHECK_THROWS_AS(blob::load<Table>(source), blob::storage_exhausted_exception);
+    }
+
+    SECTION("corrupt count") {
+        // A count of 2^32-1 elements must be detected before allocating memory for all of them
+        auto count = std::numeric_limits<std::uint32_t>::max();
+        std::memcpy(buffer.data(), &count, sizeof(count));
+
+        blob::checked_memory_storage checked_source { { buffer.data(), buffer.data(), buffer.data() + table_size } };
+        CHECK_THROWS_AS(blob::load<Table>(checked_source), blob::storage_exhausted_exception);
+
+        auto stream = make_stream(buffer, table_size);
+        blob::istream_storage stream_source { { stream } };
+        CHECK_THROWS_AS(blob::load<Table>(stream_source), blob::storage_exhausted_exception);
+    }
+}
@@ -0,0 +1,101 @@
+#include <blobify/blobify.hpp>
+#include <blobify/modify.hpp>
+#include <blobify/try_load.hpp>
+#include <blobify/vector_storage.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+struct Record {
+    std::uint32_t id;
+    std::uint16_t value;
+};
+
+constexpr auto properties(blob::tag<Record>) {
+    blob::properties_t<Record> props { };
+    props.member<&Record::value>().endianness = blob::endian::big;
+    return props;
+}
+
+constexpr std::size_t record_size = 4 + 2;
+
+} // anonymous namespace
+
+TEST_CASE("vector_storage grows on stores") {
+    blob::vector_storage storage;
+
+    SECTION("store") {
+        blob::store(storage, Record { 1, 0x1020 });
+        blob::store(storage, Record { 2, 0x3040 });
+        CHECK(storage.size() == 2 * record_size);
+        CHECK(storage.position() == 2 * record_size);
+        CHECK(storage.data()[record_size + 4] == std::byte { 0x30 });
+    }
+
+    SECTION("store_many") {
+        std::vector<Record> records(100, Record { 7, 8 });
+        blob::store_many(storage, records);
+        CHECK(storage.size() == 100 * record_size);
+
+        auto source = blob::memory_storage { const_cast<std::byte*>(storage.data()), const_cast<std::byte*>(storage.data()),
+                                             const_cast<std::byte*>(storage.data()) + storage.size() };
+        CHECK(blob::load_many<std::vector<Record>>(source, 100)[99].value == 8);
+    }
+
+    SECTION("release") {
+        blob::store(storage, Record { 1, 2 });
+        auto buffer = storage.release();
+        CHECK(buffer.size() == record_size);
+        CHECK(storage.size() == 0);
+        CHECK(storage.position() == 0);
+
+        // The released buffer is reused and appended to
+        blob::vector_storage reused { std::move(buffer) };
+        blob::store(reused, Record { 3, 4 });
+        CHECK(reused.size() == 2 * record_size);
+        CHECK(reused.data()[record_size] == std::byte { 3 });
+    }
+
+    SECTION("reuse after clear") {
+        blob::store_many(storage, std::vector<Record>(4, Record { 0xffffffff, 0xffff }));
+        auto data = storage.data();
+        storage.clear();
+        CHECK(storage.size() == 0);
+
+        blob::store(storage, Record { 5, 6 });
+        CHECK(storage.data() == data);
+        CHECK(storage.size() == record_size);
+
+        // Reserved space doesn't retain data discarded by clear()
+        storage.clear();
+        storage.require_store(record_size);
+        CHECK(storage.size() == record_size);
+        for (std::size_t i = 0; i < record_size; ++i) {
+            CHECK(storage.data()[i] == std::byte { 0 });
+        }
+    }
+}
+
+TEST_CASE("vector_storage loads are checked against the stored data") {
+    blob::vector_storage storage;
+    blob::store(storage, Record { 1, 2 });
+
+    // The cursor is at the end of the stored data
+    CHECK_THROWS_AS(blob::load<Record>(storage), blob::storage_exhausted_exception);
+    CHECK(blob::try_load<Record>(storage).error().kind == blob::error_kind::storage_exhausted);
+    CHECK_THROWS_AS(blob::lens_load<&Record::value>(storage), blob::storage_exhausted_exception);
+    CHECK_THROWS_AS(blob::lens_modify<&Record::value>(storage, [](auto value) { return value + 1; }), blob::storage_exhausted_exception);
+    CHECK(storage.size() == record_size);
+
+    storage.seek(-static_cast<std::ptrdiff_t>(record_size));
+    blob::lens_modify<&Record::value>(storage, [](auto value) { return value + 1; });
+    CHECK(blob::lens_load<&Record::value>(storage) == 3);
+    auto record = blob::load<Record>(storage);
+    CHECK(record.id == 1);
+    CHECK(record.value == 3);
+    CHECK(storage.size() == record_size);
+}